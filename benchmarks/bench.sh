@@ -0,0 +1,29 @@
+#!/bin/bash
+# Kompiliert jeden Benchmark (benchmarks/*.gc) mit gppc und misst die Laufzeit.
+# C++-Vergleichsprogramme (benchmarks/*.cpp) übersetzt g++ mit denselben Flags wie gppc.
+# Aufruf über `make bench` aus dem Projektverzeichnis.
+
+cd "$(dirname "$0")/.." || exit 1
+TIMEFORMAT="%R s"
+
+for quelle in benchmarks/*.gc; do
+    programm="${quelle%.gc}"
+    if ! ./gppc "$quelle" > /dev/null; then
+        echo "-> [bench] Fehler beim Kompilieren von $quelle"
+        exit 1
+    fi
+    printf -- "-> [bench] %-40s " "$quelle"
+    { time "./$programm" > /dev/null; } 2>&1
+    rm -f "$programm"
+done
+
+for quelle in benchmarks/*.cpp; do
+    programm="${quelle%.cpp}"
+    if ! g++ -std=c++17 -O2 -pthread -fopenmp-simd -o "$programm" "$quelle"; then
+        echo "-> [bench] Fehler beim Kompilieren von $quelle"
+        exit 1
+    fi
+    printf -- "-> [bench] %-40s " "$quelle"
+    { time "./$programm" > /dev/null; } 2>&1
+    rm -f "$programm"
+done
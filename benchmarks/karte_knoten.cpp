@@ -0,0 +1,41 @@
+// karte_knoten.cpp
+// Benchmark: Dieselbe Arbeit wie karte_offen.gc, aber mit std::unordered_map,
+// die jeden Eintrag in einem eigenen Knoten auf dem Heap ablegt.
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+int main() {
+    std::unordered_map<int, int> zahlen;
+    for (int i = 0; i < 1000000; i = i + 1) {
+        int j = (i % 1000) * 1000 + i / 1000;
+        zahlen[j * 7] = j;
+    }
+    int treffer = 0;
+    for (int runde = 0; runde < 10; runde = runde + 1) {
+        for (int i = 0; i < 1000000; i = i + 1) {
+            int j = (i % 997) * 1003 + i / 997;
+            if (zahlen.count(j * 3)) {
+                treffer = treffer + 1;
+            }
+        }
+    }
+
+    std::vector<std::string> woerter;
+    for (int i = 0; i < 100000; i = i + 1) {
+        woerter.push_back("wort" + std::to_string(i * 13 % 50000));
+    }
+    std::unordered_map<std::string, int> haeufigkeit;
+    for (int runde = 0; runde < 20; runde = runde + 1) {
+        for (std::size_t i = 0; i < woerter.size(); i = i + 1) {
+            haeufigkeit[woerter[i]] += 1;
+        }
+    }
+
+    std::cout << treffer << '\n';
+    std::cout << haeufigkeit.size() << '\n';
+    std::cout << haeufigkeit["wort42"] << '\n';
+    return 0;
+}
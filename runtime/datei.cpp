@@ -0,0 +1,126 @@
+#include "gerlang_datei.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t SCHREIBPUFFER = 1 << 20;
+
+struct Schreiber {
+    std::unique_ptr<char[]> puffer = std::make_unique<char[]>(SCHREIBPUFFER);
+    std::ofstream datei;
+};
+
+struct Einblendung {
+    std::string_view inhalt;
+    std::streamoff geschrieben = -1;    // Stand des eigenen Schreibers beim Einblenden; -1 = keiner.
+    bool sequentiell = false;
+};
+
+// Eingeblendete Dateien und offene Ausgabedateien des Programms. Die Ausgabedateien
+// werden im Destruktor geschrieben; die Einblendungen bleiben bis zum Programmende,
+// weil noch Sichten darauf zeigen können. Jede Datei wird nur einmal eingeblendet
+// und erst wieder, wenn das Programm seitdem selbst hineingeschrieben hat.
+struct Register {
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Schreiber>, std::less<>> schreiber;
+    std::map<std::string, Einblendung, std::less<>> einblendungen;
+};
+
+Register& reg() {
+    static Register r;
+    return r;
+}
+
+[[noreturn]] void dateiFehler(std::string_view pfad, const char* was) {      // Meldet einen Fehler beim Öffnen und beendet das Programm.
+    std::fprintf(stderr, "gerlang: Datei '%.*s' kann nicht %s werden: %s\n",
+                 static_cast<int>(pfad.size()), pfad.data(), was, std::strerror(errno));
+    std::exit(1);
+}
+
+std::string_view blendeEin(std::string_view pfad, bool sequentiell) {      // Blendet die ganze Datei nur lesbar ein oder liefert die vorhandene Einblendung. Bei `sequentiell` liest der Kernel großzügig voraus. Schreibt das Programm selbst in die Datei, wird sein Puffer vorher geschrieben.
+    Register& r = reg();
+    std::lock_guard<std::mutex> sperre(r.mutex);
+    std::streamoff geschrieben = -1;
+    auto schreiber = r.schreiber.find(pfad);
+    if (schreiber != r.schreiber.end()) {
+        schreiber->second->datei.flush();
+        geschrieben = schreiber->second->datei.tellp();
+    }
+    auto vorhanden = r.einblendungen.find(pfad);
+    if (vorhanden != r.einblendungen.end() && vorhanden->second.geschrieben == geschrieben) {
+        Einblendung& e = vorhanden->second;
+        if (e.sequentiell != sequentiell && !e.inhalt.empty()) {
+            ::madvise(const_cast<char*>(e.inhalt.data()), e.inhalt.size(), sequentiell ? MADV_SEQUENTIAL : MADV_WILLNEED);
+            e.sequentiell = sequentiell;
+        }
+        return e.inhalt;
+    }
+
+    std::string name(pfad);
+    int fd = ::open(name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) dateiFehler(pfad, "gelesen");
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        dateiFehler(pfad, "gelesen");
+    }
+    std::size_t groesse = static_cast<std::size_t>(info.st_size);
+    std::string_view inhalt;
+    if (groesse > 0) {
+        void* daten = ::mmap(nullptr, groesse, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (daten == MAP_FAILED) {
+            ::close(fd);
+            dateiFehler(pfad, "gelesen");
+        }
+        ::madvise(daten, groesse, sequentiell ? MADV_SEQUENTIAL : MADV_WILLNEED);
+        inhalt = std::string_view(static_cast<const char*>(daten), groesse);
+    }
+    ::close(fd);
+    r.einblendungen[name] = Einblendung{inhalt, geschrieben, sequentiell};
+    return inhalt;
+}
+
+}
+
+std::string_view gerlang_datei_lese(std::string_view pfad) {        // DATEI_LESE(pfad): Der ganze Inhalt als Sicht in die eingeblendete Datei.
+    return blendeEin(pfad, false);
+}
+
+GerlangZeilen gerlang_datei_zeilen(std::string_view pfad) {        // DATEI_ZEILEN(pfad): Lesezeiger am Anfang der eingeblendeten Datei.
+    return GerlangZeilen(blendeEin(pfad, true));
+}
+
+std::ostream& gerlang_datei(std::string_view pfad) {       // Ziel von DATEI_SCHREIBE. Die zuletzt benutzte Datei merkt sich jeder Thread, damit Schleifen nicht jedes Mal suchen.
+    thread_local std::string letzterPfad;
+    thread_local std::ostream* letzte = nullptr;
+    if (letzte != nullptr && pfad == letzterPfad) return *letzte;
+
+    Register& r = reg();
+    std::lock_guard<std::mutex> sperre(r.mutex);
+    auto gefunden = r.schreiber.find(pfad);
+    if (gefunden == r.schreiber.end()) {
+        // Ist die Datei eingeblendet, zeigen noch Sichten hinein. Abschneiden würde ihnen die Seiten
+        // nehmen (SIGBUS); nach unlink behalten sie die alte Datei, geschrieben wird in eine neue.
+        if (r.einblendungen.count(pfad)) ::unlink(std::string(pfad).c_str());
+        auto neu = std::make_unique<Schreiber>();
+        neu->datei.rdbuf()->pubsetbuf(neu->puffer.get(), SCHREIBPUFFER);
+        neu->datei.open(std::string(pfad), std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!neu->datei.is_open()) dateiFehler(pfad, "geschrieben");
+        gefunden = r.schreiber.emplace(std::string(pfad), std::move(neu)).first;
+    }
+    letzterPfad.assign(pfad.data(), pfad.size());
+    letzte = &gefunden->second->datei;
+    return *letzte;
+}
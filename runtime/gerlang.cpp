@@ -0,0 +1,193 @@
+#include "gerlang.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <charconv>
+#include <new>
+
+#ifdef _WIN32
+#include <io.h>
+#define gerlang_read _read
+#else
+#include <unistd.h>
+#define gerlang_read read
+#endif
+
+namespace {
+
+class AusgabePuffer : public std::streambuf {      // Großer Ausgabepuffer für std::cout. Geschrieben wird erst, wenn er voll ist, bei LEERE(), vor LESE() und beim Programmende.
+public:
+    AusgabePuffer() {
+        setp(m_puffer, m_puffer + sizeof(m_puffer));
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        schreibe();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        schreibe();
+        return std::fflush(stdout);
+    }
+
+private:
+    char m_puffer[1 << 16];
+
+    void schreibe() {
+        std::fwrite(pbase(), 1, pptr() - pbase(), stdout);
+        setp(m_puffer, m_puffer + sizeof(m_puffer));
+    }
+};
+
+class Eingabe {     // Liest die Standardeingabe in großen Blöcken und zerlegt den Puffer in Zeilen.
+public:
+    bool zeile(std::string& ziel) {
+        while (true) {
+            const char* anfang = m_puffer.data() + m_anfang;
+            const char* nl = static_cast<const char*>(std::memchr(anfang, '\n', m_ende - m_anfang));
+            if (nl != nullptr) {
+                ziel.assign(anfang, nl - anfang);
+                m_anfang += (nl - anfang) + 1;
+                return true;
+            }
+            if (m_dateiende) {
+                ziel.assign(anfang, m_ende - m_anfang);
+                bool rest = m_anfang < m_ende;
+                m_anfang = m_ende;
+                return rest;
+            }
+            fuelle();
+        }
+    }
+
+    std::vector<std::string> alleZeilen() {
+        while (!m_dateiende) fuelle();
+        const char* anfang = m_puffer.data() + m_anfang;
+        const char* ende = m_puffer.data() + m_ende;
+        std::vector<std::string> zeilen;
+        zeilen.reserve(std::count(anfang, ende, '\n') + 1);
+        while (anfang < ende) {
+            const char* nl = static_cast<const char*>(std::memchr(anfang, '\n', ende - anfang));
+            const char* zeilenende = (nl != nullptr) ? nl : ende;
+            zeilen.emplace_back(anfang, zeilenende - anfang);
+            anfang = (nl != nullptr) ? nl + 1 : ende;
+        }
+        m_anfang = m_ende;
+        return zeilen;
+    }
+
+private:
+    std::vector<char> m_puffer = std::vector<char>(1 << 16);
+    std::size_t m_anfang = 0;
+    std::size_t m_ende = 0;
+    bool m_dateiende = false;
+
+    void fuelle() {
+        if (m_anfang > 0) {
+            std::memmove(m_puffer.data(), m_puffer.data() + m_anfang, m_ende - m_anfang);
+            m_ende -= m_anfang;
+            m_anfang = 0;
+        }
+        if (m_ende == m_puffer.size()) m_puffer.resize(m_puffer.size() * 2);
+        auto n = gerlang_read(0, m_puffer.data() + m_ende, m_puffer.size() - m_ende);
+        if (n <= 0) m_dateiende = true;
+        else m_ende += n;
+    }
+};
+
+int init_zaehler = 0;
+alignas(AusgabePuffer) unsigned char ausgabe_speicher[sizeof(AusgabePuffer)];
+AusgabePuffer* ausgabe = nullptr;
+std::streambuf* alter_puffer = nullptr;
+
+Eingabe& eingabe() {
+    static Eingabe e;
+    return e;
+}
+
+const char* zahlanfang(std::string_view s) {        // Überspringt führende Leerzeichen und ein '+' (wie std::stoi).
+    std::size_t i = 0;
+    while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) ++i;
+    if (i + 1 < s.size() && s[i] == '+' && s[i + 1] != '-') ++i;
+    return s.data() + i;
+}
+
+}
+
+GerlangInit::GerlangInit() {        // Schaltet die stdio-Synchronisation ab und hängt den Ausgabepuffer an std::cout.
+    if (init_zaehler++ == 0) {
+        std::ios::sync_with_stdio(false);
+        ausgabe = new (ausgabe_speicher) AusgabePuffer();
+        alter_puffer = std::cout.rdbuf(ausgabe);
+    }
+}
+
+GerlangInit::~GerlangInit() {       // Schreibt den Ausgabepuffer beim Programmende und gibt std::cout den alten Puffer zurück.
+    if (--init_zaehler == 0) {
+        std::cout.flush();
+        std::cout.rdbuf(alter_puffer);
+        ausgabe->~AusgabePuffer();
+    }
+}
+
+std::string gerlang_lese() {        // Liest eine Zeile von der Standardeingabe. Vorher wird die Ausgabe geschrieben, damit Fragen sichtbar sind.
+    std::cout.flush();
+    std::string line;
+    eingabe().zeile(line);
+    return line;
+}
+
+std::vector<std::string> gerlang_lese_alle() {      // Liest die restliche Standardeingabe in einem Durchgang als Liste von Zeilen.
+    std::cout.flush();
+    return eingabe().alleZeilen();
+}
+
+int gerlang_zu_ganz(std::string_view s) {       // Wandelt einen String in eine Ganzzahl um (0 bei ungültiger Eingabe, ohne Exceptions).
+    int wert = 0;
+    auto ergebnis = std::from_chars(zahlanfang(s), s.data() + s.size(), wert);
+    return ergebnis.ec == std::errc() ? wert : 0;
+}
+
+float gerlang_zu_komma(std::string_view s) {        // Wandelt einen String in eine Kommazahl um (0.0 bei ungültiger Eingabe, ohne Exceptions).
+    float wert = 0.0f;
+    auto ergebnis = std::from_chars(zahlanfang(s), s.data() + s.size(), wert);
+    return ergebnis.ec == std::errc() ? wert : 0.0f;
+}
+
+std::string gerlang_verbinde(std::initializer_list<std::string_view> teile) {       // Verbindet mehrere Strings mit genau einer Allokation.
+    std::size_t laenge = 0;
+    for (std::string_view t : teile) laenge += t.size();
+    std::string ergebnis;
+    ergebnis.reserve(laenge);
+    for (std::string_view t : teile) ergebnis.append(t.data(), t.size());
+    return ergebnis;
+}
+
+void gerlang_anhaengen(std::string& ziel, std::initializer_list<std::string_view> teile) {      // Hängt Strings an `ziel` an (s = s + a + b), ohne `ziel` neu aufzubauen.
+    std::size_t laenge = ziel.size();
+    bool ueberlappt = false;
+    for (std::string_view t : teile) {
+        laenge += t.size();
+        if (t.data() >= ziel.data() && t.data() <= ziel.data() + ziel.size()) ueberlappt = true;
+    }
+    if (laenge > ziel.capacity()) {
+        std::size_t kapazitaet = std::max(laenge, 2 * ziel.capacity());
+        if (ueberlappt) {
+            std::string neu;
+            neu.reserve(kapazitaet);
+            neu.append(ziel);
+            for (std::string_view t : teile) neu.append(t.data(), t.size());
+            ziel.swap(neu);
+            return;
+        }
+        ziel.reserve(kapazitaet);
+    }
+    for (std::string_view t : teile) ziel.append(t.data(), t.size());
+}
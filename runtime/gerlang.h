@@ -0,0 +1,97 @@
+#pragma once
+
+/*
+ * gerlang.h - Laufzeitbibliothek für von gppc erzeugte Programme.
+ *
+ * Jedes generierte Programm bindet nur diesen Header ein und wird gegen die
+ * vorkompilierte libgerlang.a gelinkt (siehe Makefile). Die Funktionen heißen
+ * wie die Helper, die früher als Text in jedes Programm geschrieben wurden.
+ */
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <initializer_list>
+#include <algorithm>
+#include <type_traits>
+#include "gerlang_parallel.h"
+#include "gerlang_merke.h"
+#include "gerlang_karte.h"
+#include "gerlang_datei.h"
+
+#ifdef GERLANG_ZEILENWEISE     // Mit -DGERLANG_ZEILENWEISE wird wie früher nach jeder Zeile geflusht.
+#define GERLANG_ZEILENENDE std::endl
+#else
+#define GERLANG_ZEILENENDE '\n'
+#endif
+
+// Aufruf einer constexpr-Funktion, den gppc als konstant erkannt hat. Die Variable
+// zwingt g++, ihn beim Kompilieren auszuwerten; im Programm steht nur noch das Ergebnis.
+#define GERLANG_KONSTANT(typ, ...) ([]() -> typ { constexpr typ gerlang_wert = (__VA_ARGS__); return gerlang_wert; }())
+
+// Installiert den großen Ausgabepuffer für std::cout beim ersten Einbinden und
+// schreibt ihn beim Programmende (Nifty-Counter, wie std::ios_base::Init).
+class GerlangInit {
+public:
+    GerlangInit();
+    ~GerlangInit();
+};
+static GerlangInit gerlang_init;
+
+std::string gerlang_lese();
+std::vector<std::string> gerlang_lese_alle();
+
+int gerlang_zu_ganz(std::string_view s);
+float gerlang_zu_komma(std::string_view s);
+
+template <typename T>
+std::string gerlang_zu_wort(T s) { return std::to_string(s); }     // Wandelt verschiedene Typen (Zahlen etc.) in einen String um.
+
+inline std::string gerlang_zu_wort(std::string_view s) { return std::string(s); }     // ZU_WORT(sicht): Kopiert eine SICHT in ein eigenes WORT.
+
+template <typename C>
+int gerlang_laenge(const C& c) { return static_cast<int>(c.size()); }     // LAENGE(a)
+
+template <typename C>
+void gerlang_reserviere(C& c, long long zusatz) {       // Reserviert vor einer Schleife Platz für `zusatz` weitere Elemente (mindestens geometrisch, damit verschachtelte Schleifen nicht quadratisch werden).
+    if (zusatz <= 0) return;
+    std::size_t benoetigt = c.size() + static_cast<std::size_t>(zusatz);
+    if (benoetigt > c.capacity()) c.reserve(std::max(benoetigt, 2 * c.capacity()));
+}
+
+// SUMME(a): Summiert in 8 unabhängigen Teilsummen. Diese Form vektorisiert g++
+// schon bei -O2 (auch für KOMMA, da die Reihenfolge der Additionen festliegt).
+template <typename T>
+T gerlang_summe(const T* daten, std::size_t anzahl) {
+    T teil[8] = {};
+    std::size_t i = 0;
+    for (; i + 8 <= anzahl; i += 8) {
+        for (int k = 0; k < 8; ++k) teil[k] += daten[i + k];
+    }
+    T summe{};
+    for (; i < anzahl; ++i) summe += daten[i];
+    for (int k = 0; k < 8; ++k) summe += teil[k];
+    return summe;
+}
+
+// Alles außer GANZ und KOMMA (die Analyse lässt nur die zu, wenn sie den Typ kennt)
+// wird der Reihe nach addiert; std::vector<bool> hat auch kein data().
+template <typename C>
+auto gerlang_summe(const C& c) {
+    using T = typename C::value_type;
+    if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+        return gerlang_summe(c.data(), c.size());
+    } else {
+        T summe{};
+        for (const T& wert : c) summe += wert;
+        return summe;
+    }
+}
+
+template <typename C>
+void gerlang_sortiere(C& c) { std::sort(c.begin(), c.end()); }     // SORTIERE(a)
+
+std::string gerlang_verbinde(std::initializer_list<std::string_view> teile);
+void gerlang_anhaengen(std::string& ziel, std::initializer_list<std::string_view> teile);
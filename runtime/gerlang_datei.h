@@ -0,0 +1,50 @@
+#pragma once
+
+/*
+ * gerlang_datei.h - Dateien lesen und schreiben (DATEI_LESE, DATEI_ZEILEN,
+ * DATEI_SCHREIBE).
+ *
+ * Gelesene Dateien werden mit mmap eingeblendet und bleiben bis zum
+ * Programmende eingeblendet. Jede Datei wird beim ersten Lesen eingeblendet
+ * und erst wieder, nachdem das Programm selbst hineingeschrieben hat.
+ * DATEI_LESE liefert den Inhalt als SICHT (std::string_view) ohne Kopie,
+ * DATEI_ZEILEN zerlegt ihn erst beim Lesen mit LESE(z) in Zeilen, die wieder
+ * Sichten in die Datei sind. Eine große Datei
+ * kostet so Seitenfehler, aber keine Allokation pro Zeile.
+ * DATEI_SCHREIBE schreibt über einen großen Puffer pro Datei; die erste
+ * Ausgabe in eine Datei legt sie neu an, das Programmende schreibt den Rest.
+ * Liest das Programm eine Datei, in die es selbst schreibt, sieht es alles
+ * bis dahin Geschriebene. Schreibt es in eine Datei, die es schon gelesen hat,
+ * entsteht eine neue Datei; frühere Sichten behalten den alten Inhalt.
+ */
+
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+// Lesezeiger über die Zeilen einer eingeblendeten Datei (Typ ZEILEN).
+class GerlangZeilen {
+public:
+    explicit GerlangZeilen(std::string_view text) : m_zeiger(text.data()), m_ende(text.data() + text.size()) {}
+
+    bool ende() const { return m_zeiger == m_ende; }      // DATEI_ENDE(z)
+
+    std::string_view naechste() {       // LESE(z): Die nächste Zeile ohne '\n'; am Dateiende "".
+        const char* anfang = m_zeiger;
+        const char* nl = static_cast<const char*>(std::memchr(anfang, '\n', static_cast<std::size_t>(m_ende - anfang)));
+        if (nl == nullptr) {
+            m_zeiger = m_ende;
+            return std::string_view(anfang, static_cast<std::size_t>(m_ende - anfang));
+        }
+        m_zeiger = nl + 1;
+        return std::string_view(anfang, static_cast<std::size_t>(nl - anfang));
+    }
+
+private:
+    const char* m_zeiger;
+    const char* m_ende;
+};
+
+std::string_view gerlang_datei_lese(std::string_view pfad);
+GerlangZeilen gerlang_datei_zeilen(std::string_view pfad);
+std::ostream& gerlang_datei(std::string_view pfad);
@@ -0,0 +1,141 @@
+#pragma once
+
+/*
+ * gerlang_karte.h - Der Typ KARTE<K, V>.
+ *
+ * Eine Hash-Tabelle mit offener Adressierung statt std::unordered_map. Die
+ * Einträge liegen dicht hintereinander in einem std::vector (in
+ * Einfügereihenfolge, so ist auch SCHLUESSEL(m) stabil). Die Tabelle daneben
+ * speichert pro Platz den Index des Eintrags und bei WORT 32 Bit des Hashs,
+ * bei GANZ, KOMMA und JAIN gleich den Schlüssel selbst; acht Plätze passen in
+ * eine Cache-Zeile. Eine Suche vergleicht zuerst in der Tabelle und liest dann
+ * genau einen Eintrag (ENTHAELT mit Zahlschlüssel gar keinen); std::unordered_map
+ * folgt dagegen pro Schlüssel einem Zeiger auf einen eigenen Knoten im Heap.
+ * Kollisionen werden linear auf den folgenden Plätzen aufgelöst.
+ * Eine KARTE mit WORT-Schlüsseln sucht auch mit einer SICHT, ohne sie zu kopieren.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "gerlang_merke.h"
+
+template <typename K, typename V>
+class GerlangKarte {
+    // Typ, mit dem gesucht wird: std::hash<std::string_view> liefert denselben Wert wie std::hash<std::string>.
+    using Suche = std::conditional_t<std::is_same_v<K, std::string>, std::string_view, K>;
+
+public:
+    GerlangKarte() = default;
+
+    GerlangKarte(std::initializer_list<std::pair<K, V>> paare) {        // KARTE-Literal {k: v, ...}; spätere gleiche Schlüssel überschreiben frühere.
+        reserve(paare.size());
+        for (auto& paar : paare) (*this)[paar.first] = paar.second;
+    }
+
+    std::size_t size() const { return m_eintraege.size(); }
+
+    void reserve(std::size_t anzahl) {      // Vergrößert die Tabelle so, dass `anzahl` Einträge ohne Umbau passen.
+        m_eintraege.reserve(anzahl);
+        std::size_t plaetze = 16;
+        while (plaetze * 2 < anzahl * 3) plaetze *= 2;
+        if (plaetze > m_plaetze.size()) baueTabelle(plaetze);
+    }
+
+    V& operator[](Suche schluessel) {        // m[k] = v: legt einen fehlenden Schlüssel mit V{} an.
+        std::uint64_t hash = hashVon(schluessel);
+        std::size_t platz = suche(schluessel, hash);
+        if (platz != KEIN_PLATZ && m_plaetze[platz].index != FREI) {
+            return m_eintraege[m_plaetze[platz].index].second;
+        }
+        if ((m_eintraege.size() + 1) * 3 > m_plaetze.size() * 2) {
+            baueTabelle(m_plaetze.empty() ? 16 : m_plaetze.size() * 2);
+            platz = suche(schluessel, hash);
+        }
+        m_plaetze[platz] = {kennung(schluessel, hash), static_cast<std::uint32_t>(m_eintraege.size())};
+        m_eintraege.emplace_back(K(schluessel), V{});
+        return m_eintraege.back().second;
+    }
+
+    V lies(Suche schluessel) const {     // Lesen von m[k]: V{} für einen fehlenden Schlüssel, ohne ihn anzulegen (auch aus mehreren Threads).
+        const V* wert = finde(schluessel);
+        return wert != nullptr ? *wert : V{};
+    }
+
+    bool enthaelt(Suche schluessel) const { return finde(schluessel) != nullptr; }      // ENTHAELT(m, k)
+
+    std::vector<K> schluessel() const {         // SCHLUESSEL(m): alle Schlüssel in Einfügereihenfolge.
+        std::vector<K> ergebnis;
+        ergebnis.reserve(m_eintraege.size());
+        for (auto& eintrag : m_eintraege) ergebnis.push_back(eintrag.first);
+        return ergebnis;
+    }
+
+private:
+    // Zahlen und JAIN stehen direkt in der Tabelle, von WORT nur die unteren 32 Bit des Hashs.
+    static constexpr bool DIREKT = std::is_arithmetic_v<K> && sizeof(K) <= 4;
+    using Kennung = std::conditional_t<DIREKT, K, std::uint32_t>;
+
+    struct Platz {
+        Kennung kennung;            // Spart bei WORT die meisten Schlüsselvergleiche, ersetzt sie bei Zahlen ganz.
+        std::uint32_t index;        // Position in m_eintraege, FREI für einen leeren Platz.
+    };
+
+    static constexpr std::uint32_t FREI = 0xFFFFFFFFu;
+    static constexpr std::size_t KEIN_PLATZ = static_cast<std::size_t>(-1);
+
+    std::vector<std::pair<K, V>> m_eintraege;
+    std::vector<Platz> m_plaetze;       // Zweierpotenz, höchstens zu 2/3 belegt.
+
+    static std::uint64_t hashVon(Suche schluessel) { return gerlang_mische(std::hash<Suche>{}(schluessel)); }
+
+    static Kennung kennung(Suche schluessel, std::uint64_t hash) {
+        if constexpr (DIREKT) {
+            return schluessel;
+        } else {
+            return static_cast<std::uint32_t>(hash);
+        }
+    }
+
+    bool gleich(const Platz& p, Suche schluessel, Kennung k) const {
+        if constexpr (DIREKT) {
+            return p.kennung == k;
+        } else {
+            return p.kennung == k && m_eintraege[p.index].first == schluessel;
+        }
+    }
+
+    std::size_t suche(Suche schluessel, std::uint64_t hash) const {      // Platz des Schlüssels oder der erste freie Platz dahinter; KEIN_PLATZ bei leerer Tabelle.
+        if (m_plaetze.empty()) return KEIN_PLATZ;
+        std::size_t maske = m_plaetze.size() - 1;
+        Kennung k = kennung(schluessel, hash);
+        for (std::size_t platz = static_cast<std::size_t>(hash >> 32) & maske;; platz = (platz + 1) & maske) {
+            const Platz& p = m_plaetze[platz];
+            if (p.index == FREI) return platz;
+            if (gleich(p, schluessel, k)) return platz;
+        }
+    }
+
+    const V* finde(Suche schluessel) const {
+        std::size_t platz = suche(schluessel, hashVon(schluessel));
+        if (platz == KEIN_PLATZ || m_plaetze[platz].index == FREI) return nullptr;
+        return &m_eintraege[m_plaetze[platz].index].second;
+    }
+
+    void baueTabelle(std::size_t plaetze) {     // Verteilt alle Einträge neu auf eine Tabelle mit `plaetze` Plätzen.
+        m_plaetze.assign(plaetze, Platz{Kennung{}, FREI});
+        std::size_t maske = plaetze - 1;
+        for (std::size_t i = 0; i < m_eintraege.size(); ++i) {
+            std::uint64_t hash = hashVon(m_eintraege[i].first);
+            std::size_t platz = static_cast<std::size_t>(hash >> 32) & maske;
+            while (m_plaetze[platz].index != FREI) platz = (platz + 1) & maske;
+            m_plaetze[platz] = {kennung(m_eintraege[i].first, hash), static_cast<std::uint32_t>(i)};
+        }
+    }
+};
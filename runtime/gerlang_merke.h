@@ -0,0 +1,138 @@
+#pragma once
+
+/*
+ * gerlang_merke.h - Ergebnis-Caches für MERKE-Funktionen.
+ *
+ * Der Generator erzeugt für `MERKE GANZ f(GANZ n)` eine Hülle um die
+ * eigentliche Funktion, die das Ergebnis pro Argument-Tupel in einem
+ * thread_local Cache ablegt. Ohne WORT-Parameter ist das eine flache Tabelle
+ * mit offener Adressierung, mit WORT-Parametern eine std::unordered_map.
+ * Erreicht ein Cache seine Grenze, wird er geleert.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef GERLANG_MERKE_GRENZE     // Standardgrenze in Einträgen pro Funktion und Thread (gppc --merke-grenze=N).
+#define GERLANG_MERKE_GRENZE (1 << 20)
+#endif
+
+inline std::uint64_t gerlang_mische(std::uint64_t x) {      // Finalisierer aus splitmix64: verteilt auch fortlaufende Zahlen gleichmäßig.
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+struct GerlangTupelHash {
+    static std::uint64_t teil(int v) { return static_cast<std::uint32_t>(v); }
+    static std::uint64_t teil(bool v) { return v ? 1 : 0; }
+    static std::uint64_t teil(float v) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits;
+    }
+    static std::uint64_t teil(const std::string& v) { return std::hash<std::string>{}(v); }
+
+    template <typename... A>
+    std::size_t operator()(const std::tuple<A...>& t) const {
+        std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+        std::apply([&h](const A&... a) { ((h = gerlang_mische(h ^ teil(a))), ...); }, t);
+        return static_cast<std::size_t>(h);
+    }
+};
+
+// Flache Tabelle mit linearer Suche; Schlüssel und Wert liegen im selben Eintrag.
+template <typename K, typename V>
+class GerlangMerkTabelle {
+public:
+    explicit GerlangMerkTabelle(std::size_t grenze) : m_grenze(grenze > 0 ? grenze : 1) {}
+
+    const V* finde(const K& schluessel) const {
+        if (m_eintraege.empty()) return nullptr;
+        std::size_t maske = m_eintraege.size() - 1;
+        for (std::size_t i = GerlangTupelHash{}(schluessel) & maske;; i = (i + 1) & maske) {
+            const Eintrag& e = m_eintraege[i];
+            if (!e.belegt) return nullptr;
+            if (e.schluessel == schluessel) return &e.wert;
+        }
+    }
+
+    void speichere(K schluessel, V wert) {
+        if (m_anzahl >= m_grenze) leere();
+        if ((m_anzahl + 1) * 2 > m_eintraege.size()) wachse();
+        if (einfuegen(std::move(schluessel), std::move(wert))) ++m_anzahl;
+    }
+
+private:
+    struct Eintrag {
+        K schluessel{};
+        V wert{};
+        bool belegt = false;
+    };
+
+    std::vector<Eintrag> m_eintraege;
+    std::size_t m_anzahl = 0;
+    std::size_t m_grenze;
+
+    bool einfuegen(K schluessel, V wert) {      // Liefert true, wenn ein neuer Eintrag belegt wurde.
+        std::size_t maske = m_eintraege.size() - 1;
+        for (std::size_t i = GerlangTupelHash{}(schluessel) & maske;; i = (i + 1) & maske) {
+            Eintrag& e = m_eintraege[i];
+            if (!e.belegt) {
+                e.schluessel = std::move(schluessel);
+                e.wert = std::move(wert);
+                e.belegt = true;
+                return true;
+            }
+            if (e.schluessel == schluessel) {
+                e.wert = std::move(wert);
+                return false;
+            }
+        }
+    }
+
+    void wachse() {
+        std::vector<Eintrag> alt;
+        alt.swap(m_eintraege);
+        m_eintraege.resize(alt.empty() ? 64 : alt.size() * 2);
+        for (Eintrag& e : alt) {
+            if (e.belegt) einfuegen(std::move(e.schluessel), std::move(e.wert));
+        }
+    }
+
+    void leere() {      // Behält den Speicher, damit die Tabelle nach dem Leeren nicht neu wachsen muss.
+        for (Eintrag& e : m_eintraege) e = Eintrag{};
+        m_anzahl = 0;
+    }
+};
+
+// Für Schlüssel mit WORT: Knoten-basierte Map, damit lange Strings nicht beim Wachsen kopiert werden.
+template <typename K, typename V>
+class GerlangMerkHash {
+public:
+    explicit GerlangMerkHash(std::size_t grenze) : m_grenze(grenze > 0 ? grenze : 1) {}
+
+    const V* finde(const K& schluessel) const {
+        auto it = m_map.find(schluessel);
+        return it == m_map.end() ? nullptr : &it->second;
+    }
+
+    void speichere(K schluessel, V wert) {
+        if (m_map.size() >= m_grenze) m_map.clear();
+        m_map.insert_or_assign(std::move(schluessel), std::move(wert));
+    }
+
+private:
+    std::unordered_map<K, V, GerlangTupelHash> m_map;
+    std::size_t m_grenze;
+};
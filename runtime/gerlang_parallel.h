@@ -0,0 +1,146 @@
+#pragma once
+
+/*
+ * gerlang_parallel.h - Thread-Pool mit Work-Stealing für PARALLEL FUER und AUFGABE/WARTE.
+ *
+ * Jeder Worker hat eine eigene Warteschlange. Neue Aufgaben landen in der
+ * Schlange des Threads, der sie erzeugt. Ein Worker arbeitet seine eigene
+ * Schlange von hinten ab und stiehlt bei Leerlauf von vorne aus fremden
+ * Schlangen. Wartende Threads helfen mit (hilf()), statt zu blockieren.
+ *
+ * AUFGABE f(x) wird sofort im aufrufenden Thread ausgeführt, wenn bereits
+ * genug Aufgaben warten (ausgelastet()). So erzeugen tief rekursive
+ * Programme keine Flut winziger Tasks.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+class GerlangPool {
+public:
+    static GerlangPool& instanz();
+
+    void starte(std::function<void()> aufgabe);
+    bool hilf();
+    bool ausgelastet() const { return m_ausstehend.load(std::memory_order_relaxed) >= m_grenze; }
+    std::size_t anzahlWorker() const { return m_threads.size(); }
+
+    ~GerlangPool();
+
+private:
+    struct Warteschlange {
+        std::mutex mutex;
+        std::deque<std::function<void()>> aufgaben;
+    };
+
+    std::vector<std::unique_ptr<Warteschlange>> m_schlangen;       // [0] gehört allen Threads außerhalb des Pools (z.B. main).
+    std::vector<std::thread> m_threads;
+    std::atomic<int> m_ausstehend{0};
+    std::atomic<bool> m_ende{false};
+    int m_grenze = 0;       // Ab so vielen wartenden Aufgaben läuft AUFGABE direkt im Aufrufer.
+    std::mutex m_schlafMutex;
+    std::condition_variable m_aufwecken;
+
+    GerlangPool();
+    void arbeite(std::size_t index);
+    bool nimm(std::size_t index, std::function<void()>& aufgabe);
+};
+
+// Führt f(von, bis) für Teilbereiche von [start, ende) parallel aus und wartet auf alle Teile.
+template <typename F>
+void gerlang_parallel_fuer(long long start, long long ende, F&& f) {
+    if (ende <= start) return;
+    GerlangPool& pool = GerlangPool::instanz();
+    long long anzahl = ende - start;
+    long long stuecke = std::min<long long>(anzahl, static_cast<long long>(pool.anzahlWorker() + 1) * 4);
+    if (stuecke <= 1) {
+        f(start, ende);
+        return;
+    }
+
+    std::atomic<long long> offen(stuecke);
+    auto teil = [&](long long k) {
+        long long von = start + anzahl * k / stuecke;
+        long long bis = start + anzahl * (k + 1) / stuecke;
+        f(von, bis);
+        offen.fetch_sub(1, std::memory_order_release);
+    };
+    for (long long k = 1; k < stuecke; ++k) {
+        pool.starte([&teil, k] { teil(k); });
+    }
+    teil(0);
+    while (offen.load(std::memory_order_acquire) > 0) {
+        if (!pool.hilf()) std::this_thread::yield();
+    }
+}
+
+// Wie gerlang_parallel_fuer, aber jeder Teil liefert eine Teilsumme. Die Teilsummen
+// werden in fester Reihenfolge addiert, damit das Ergebnis (auch für KOMMA) reproduzierbar ist.
+template <typename T, typename F>
+T gerlang_parallel_summe(long long start, long long ende, F&& f) {
+    if (ende <= start) return T{};
+    GerlangPool& pool = GerlangPool::instanz();
+    long long anzahl = ende - start;
+    long long stuecke = std::min<long long>(anzahl, static_cast<long long>(pool.anzahlWorker() + 1) * 4);
+    std::vector<T> teilsummen(stuecke);
+    gerlang_parallel_fuer(0, stuecke, [&](long long von, long long bis) {
+        for (long long k = von; k < bis; ++k) {
+            teilsummen[k] = f(start + anzahl * k / stuecke, start + anzahl * (k + 1) / stuecke);
+        }
+    });
+    T summe{};
+    for (const T& t : teilsummen) summe += t;
+    return summe;
+}
+
+// Handle einer mit AUFGABE gestarteten Funktion. WARTE(h) liefert das Ergebnis.
+template <typename T>
+class GerlangAufgabe {
+public:
+    struct Zustand {
+        std::atomic<bool> fertig{false};
+        std::optional<T> ergebnis;
+    };
+
+    explicit GerlangAufgabe(std::shared_ptr<Zustand> zustand) : m_zustand(std::move(zustand)) {}
+
+    const T& warte() const {
+        GerlangPool& pool = GerlangPool::instanz();
+        while (!m_zustand->fertig.load(std::memory_order_acquire)) {
+            if (!pool.hilf()) std::this_thread::yield();
+        }
+        return *m_zustand->ergebnis;
+    }
+
+private:
+    std::shared_ptr<Zustand> m_zustand;
+};
+
+// AUFGABE f(args...): Startet f als Task. Die Argumente werden kopiert.
+template <typename F, typename... A>
+auto gerlang_starte(F f, A... args) -> GerlangAufgabe<decltype(f(args...))> {
+    using T = decltype(f(args...));
+    auto zustand = std::make_shared<typename GerlangAufgabe<T>::Zustand>();
+    GerlangPool& pool = GerlangPool::instanz();
+    if (pool.anzahlWorker() == 0 || pool.ausgelastet()) {
+        zustand->ergebnis.emplace(f(args...));
+        zustand->fertig.store(true, std::memory_order_release);
+    } else {
+        pool.starte([zustand, f, args...] {
+            zustand->ergebnis.emplace(f(args...));
+            zustand->fertig.store(true, std::memory_order_release);
+        });
+    }
+    return GerlangAufgabe<T>(zustand);
+}
+
+template <typename T>
+const T& gerlang_warte(const GerlangAufgabe<T>& aufgabe) { return aufgabe.warte(); }     // WARTE(h)
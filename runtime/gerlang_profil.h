@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+ * gerlang_profil.h - Laufzeit für `gppc --profile`.
+ *
+ * Der Generator legt in jede Funktion (und mit --profile-schleifen in jede
+ * Schleife) eine GerlangProfilMessung. Sie zählt mit dem Zeitstempelzähler
+ * der CPU und schreibt in einen Aufrufbaum, der pro Thread existiert und
+ * deshalb keine Sperren braucht. Beim Programmende schreibt
+ * GerlangProfilBericht die Auswertung (gerlang_profil.txt) und die
+ * Aufrufstapel im "folded"-Format für Flamegraphs (gerlang_profil.folded).
+ * Mit der Umgebungsvariable GERLANG_PROFIL lässt sich der Dateiname ändern.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Eine gemessene Stelle im .gc-Programm (Funktion oder Schleife).
+struct GerlangProfilOrt {
+    const char* name;
+    int zeile;
+};
+
+inline std::uint64_t gerlang_ticks() {      // Zeitstempelzähler der CPU (rdtsc), auf anderen Architekturen die steady_clock in ns.
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Aufrufbaum eines Threads: ein Knoten pro Aufrufpfad, Kinder als einfach verkettete Liste.
+struct GerlangProfilKnoten {
+    int ort;
+    int eltern;
+    int erstesKind = -1;
+    int naechstes = -1;
+    std::uint64_t anzahl = 0;
+    std::uint64_t ticks = 0;
+};
+
+struct GerlangProfilStapel {
+    std::vector<GerlangProfilKnoten> knoten{GerlangProfilKnoten{-1, -1}};      // knoten[0] ist die Wurzel.
+    int aktuell = 0;
+
+    int kind(int ort) {         // Liefert den Knoten für `ort` unterhalb des aktuellen Knotens.
+        for (int k = knoten[aktuell].erstesKind; k != -1; k = knoten[k].naechstes) {
+            if (knoten[k].ort == ort) return k;
+        }
+        return neuesKind(ort);
+    }
+    int neuesKind(int ort);
+};
+
+extern thread_local GerlangProfilStapel* gerlang_profil_stapel;
+GerlangProfilStapel* gerlang_profil_neuer_stapel();
+
+class GerlangProfilMessung {
+public:
+    explicit GerlangProfilMessung(int ort) {
+        GerlangProfilStapel* stapel = gerlang_profil_stapel;
+        if (stapel == nullptr) stapel = gerlang_profil_neuer_stapel();
+        m_stapel = stapel;
+        m_vorher = stapel->aktuell;
+        m_knoten = stapel->kind(ort);
+        stapel->aktuell = m_knoten;
+        m_start = gerlang_ticks();
+    }
+    ~GerlangProfilMessung() {
+        std::uint64_t dauer = gerlang_ticks() - m_start;
+        GerlangProfilKnoten& k = m_stapel->knoten[m_knoten];
+        ++k.anzahl;
+        k.ticks += dauer;
+        m_stapel->aktuell = m_vorher;
+    }
+    GerlangProfilMessung(const GerlangProfilMessung&) = delete;
+    GerlangProfilMessung& operator=(const GerlangProfilMessung&) = delete;
+
+private:
+    GerlangProfilStapel* m_stapel;
+    int m_vorher;
+    int m_knoten;
+    std::uint64_t m_start;
+};
+
+// Wird vom Generator vor allen anderen globalen Objekten angelegt; der Destruktor schreibt den Bericht.
+class GerlangProfilBericht {
+public:
+    GerlangProfilBericht(const GerlangProfilOrt* orte, int anzahl);
+    ~GerlangProfilBericht();
+
+private:
+    const GerlangProfilOrt* m_orte;
+    int m_anzahl;
+    std::uint64_t m_startTicks;
+    std::chrono::steady_clock::time_point m_startZeit;
+};
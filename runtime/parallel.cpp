@@ -0,0 +1,97 @@
+#include "gerlang_parallel.h"
+#include <cstdlib>
+
+namespace {
+thread_local std::size_t worker_index = 0;      // 0 = kein Pool-Thread
+}
+
+GerlangPool& GerlangPool::instanz() {       // Liefert den Pool des Programms. Er wird beim ersten PARALLEL FUER angelegt.
+    static GerlangPool pool;
+    return pool;
+}
+
+GerlangPool::GerlangPool() {        // Startet einen Worker pro zusätzlichem Kern (oder GERLANG_THREADS - 1). GERLANG_AUFGABEN_GRENZE legt fest, ab wie vielen wartenden Tasks AUFGABE direkt ausgeführt wird.
+    std::size_t threads = std::thread::hardware_concurrency();
+    if (const char* env = std::getenv("GERLANG_THREADS")) {
+        threads = static_cast<std::size_t>(std::atoi(env));
+    }
+    std::size_t worker = (threads > 1) ? threads - 1 : 0;
+
+    m_grenze = static_cast<int>(4 * (worker + 1));
+    if (const char* env = std::getenv("GERLANG_AUFGABEN_GRENZE")) {
+        m_grenze = std::atoi(env);
+    }
+
+    for (std::size_t i = 0; i <= worker; ++i) {
+        m_schlangen.push_back(std::make_unique<Warteschlange>());
+    }
+    for (std::size_t i = 1; i <= worker; ++i) {
+        m_threads.emplace_back([this, i] { arbeite(i); });
+    }
+}
+
+GerlangPool::~GerlangPool() {       // Beendet alle Worker beim Programmende.
+    {
+        std::lock_guard<std::mutex> lock(m_schlafMutex);
+        m_ende = true;
+    }
+    m_aufwecken.notify_all();
+    for (auto& t : m_threads) {
+        t.join();
+    }
+}
+
+void GerlangPool::starte(std::function<void()> aufgabe) {       // Legt eine Aufgabe in die Schlange des aufrufenden Threads.
+    Warteschlange& schlange = *m_schlangen[worker_index];
+    {
+        std::lock_guard<std::mutex> lock(schlange.mutex);
+        schlange.aufgaben.push_back(std::move(aufgabe));
+    }
+    m_ausstehend.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(m_schlafMutex);
+    }
+    m_aufwecken.notify_one();
+}
+
+bool GerlangPool::nimm(std::size_t index, std::function<void()>& aufgabe) {        // Holt eine Aufgabe: zuerst die neueste aus der eigenen Schlange, sonst die älteste aus einer fremden.
+    {
+        Warteschlange& eigene = *m_schlangen[index];
+        std::lock_guard<std::mutex> lock(eigene.mutex);
+        if (!eigene.aufgaben.empty()) {
+            aufgabe = std::move(eigene.aufgaben.back());
+            eigene.aufgaben.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i <= m_schlangen.size(); ++i) {
+        Warteschlange& fremde = *m_schlangen[(index + i) % m_schlangen.size()];
+        std::lock_guard<std::mutex> lock(fremde.mutex);
+        if (!fremde.aufgaben.empty()) {
+            aufgabe = std::move(fremde.aufgaben.front());
+            fremde.aufgaben.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GerlangPool::hilf() {      // Führt eine wartende Aufgabe im aufrufenden Thread aus. Gibt false zurück, wenn es keine gab.
+    std::function<void()> aufgabe;
+    if (m_ausstehend.load() == 0 || !nimm(worker_index, aufgabe)) {
+        return false;
+    }
+    m_ausstehend.fetch_sub(1);
+    aufgabe();
+    return true;
+}
+
+void GerlangPool::arbeite(std::size_t index) {      // Hauptschleife eines Workers: Aufgaben abarbeiten oder schlafen, bis neue kommen.
+    worker_index = index;
+    while (true) {
+        if (hilf()) continue;
+        std::unique_lock<std::mutex> lock(m_schlafMutex);
+        m_aufwecken.wait(lock, [this] { return m_ende || m_ausstehend.load() > 0; });
+        if (m_ende) return;
+    }
+}
@@ -0,0 +1,133 @@
+#include "gerlang_profil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+thread_local GerlangProfilStapel* gerlang_profil_stapel = nullptr;
+
+namespace {
+// Alle Aufrufbäume des Programms. Absichtlich nie freigegeben: Threads und
+// globale Objekte dürfen bis zum Bericht am Programmende weiter messen.
+struct Register {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<GerlangProfilStapel>> stapel;
+};
+
+Register& reg() {
+    static Register* r = new Register;
+    return *r;
+}
+
+struct Summe {
+    std::uint64_t anzahl = 0;
+    std::uint64_t inklusiv = 0;
+    std::uint64_t exklusiv = 0;
+};
+}
+
+int GerlangProfilStapel::neuesKind(int ort) {      // Hängt einen neuen Knoten an den aktuellen Knoten an.
+    GerlangProfilKnoten k{ort, aktuell};
+    k.naechstes = knoten[aktuell].erstesKind;
+    knoten.push_back(k);
+    int index = static_cast<int>(knoten.size()) - 1;
+    knoten[aktuell].erstesKind = index;
+    return index;
+}
+
+GerlangProfilStapel* gerlang_profil_neuer_stapel() {       // Legt beim ersten Messpunkt eines Threads dessen Aufrufbaum an.
+    auto stapel = std::make_unique<GerlangProfilStapel>();
+    gerlang_profil_stapel = stapel.get();
+    std::lock_guard<std::mutex> lock(reg().mutex);
+    reg().stapel.push_back(std::move(stapel));
+    return gerlang_profil_stapel;
+}
+
+GerlangProfilBericht::GerlangProfilBericht(const GerlangProfilOrt* orte, int anzahl)     // Merkt sich die Messstellen und den Startzeitpunkt zum Umrechnen der Ticks.
+    : m_orte(orte), m_anzahl(anzahl), m_startTicks(gerlang_ticks()), m_startZeit(std::chrono::steady_clock::now()) {}
+
+// Läuft den Baum ab. Inklusive Zeit zählt nur, wenn der Ort nicht schon weiter oben
+// auf dem Pfad steht, sonst würde Rekursion mehrfach gezählt.
+static void werteAus(const GerlangProfilStapel& s, int k, std::vector<int>& pfad, std::string& stapelText,
+                     std::vector<Summe>& summen, std::map<std::string, std::uint64_t>& gefaltet,
+                     const GerlangProfilOrt* orte) {
+    const GerlangProfilKnoten& knoten = s.knoten[k];
+    std::uint64_t kinder = 0;
+    for (int c = knoten.erstesKind; c != -1; c = s.knoten[c].naechstes) {
+        kinder += s.knoten[c].ticks;
+    }
+    std::uint64_t exklusiv = knoten.ticks > kinder ? knoten.ticks - kinder : 0;
+
+    Summe& summe = summen[knoten.ort];
+    summe.anzahl += knoten.anzahl;
+    summe.exklusiv += exklusiv;
+    if (std::find(pfad.begin(), pfad.end(), knoten.ort) == pfad.end()) {
+        summe.inklusiv += knoten.ticks;
+    }
+
+    std::size_t laenge = stapelText.size();
+    if (!stapelText.empty()) stapelText += ';';
+    stapelText += std::string(orte[knoten.ort].name) + ":" + std::to_string(orte[knoten.ort].zeile);
+    gefaltet[stapelText] += exklusiv;
+
+    pfad.push_back(knoten.ort);
+    for (int c = knoten.erstesKind; c != -1; c = s.knoten[c].naechstes) {
+        werteAus(s, c, pfad, stapelText, summen, gefaltet, orte);
+    }
+    pfad.pop_back();
+    stapelText.resize(laenge);
+}
+
+GerlangProfilBericht::~GerlangProfilBericht() {        // Fasst die Aufrufbäume aller Threads zusammen und schreibt Bericht und Folded-Stacks.
+    std::uint64_t ticks = gerlang_ticks() - m_startTicks;
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_startZeit).count();
+    double nsProTick = ticks > 0 ? ns / static_cast<double>(ticks) : 1.0;
+
+    std::vector<Summe> summen(m_anzahl);
+    std::map<std::string, std::uint64_t> gefaltet;
+    {
+        std::lock_guard<std::mutex> lock(reg().mutex);
+        for (auto& s : reg().stapel) {
+            std::vector<int> pfad;
+            std::string stapelText;
+            for (int c = s->knoten[0].erstesKind; c != -1; c = s->knoten[c].naechstes) {
+                werteAus(*s, c, pfad, stapelText, summen, gefaltet, m_orte);
+            }
+        }
+    }
+
+    std::string basis = "gerlang_profil";
+    if (const char* env = std::getenv("GERLANG_PROFIL")) basis = env;
+
+    std::FILE* bericht = std::fopen((basis + ".txt").c_str(), "w");
+    std::FILE* folded = std::fopen((basis + ".folded").c_str(), "w");
+    if (bericht == nullptr || folded == nullptr) {
+        std::fprintf(stderr, "[gerlang] Profil konnte nicht nach '%s.txt' geschrieben werden\n", basis.c_str());
+        if (bericht) std::fclose(bericht);
+        if (folded) std::fclose(folded);
+        return;
+    }
+
+    std::vector<int> reihenfolge;
+    for (int i = 0; i < m_anzahl; ++i) {
+        if (summen[i].anzahl > 0) reihenfolge.push_back(i);
+    }
+    std::sort(reihenfolge.begin(), reihenfolge.end(), [&](int a, int b) { return summen[a].exklusiv > summen[b].exklusiv; });
+
+    std::fprintf(bericht, "%-24s %7s %14s %14s %14s\n", "Ort", "Zeile", "Aufrufe", "inklusiv [ms]", "exklusiv [ms]");
+    for (int i : reihenfolge) {
+        std::fprintf(bericht, "%-24s %7d %14llu %14.3f %14.3f\n", m_orte[i].name, m_orte[i].zeile,
+                     static_cast<unsigned long long>(summen[i].anzahl),
+                     summen[i].inklusiv * nsProTick / 1e6, summen[i].exklusiv * nsProTick / 1e6);
+    }
+    for (auto& [stapel, exklusiv] : gefaltet) {
+        auto mikrosekunden = static_cast<unsigned long long>(exklusiv * nsProTick / 1e3);
+        if (mikrosekunden > 0) std::fprintf(folded, "%s %llu\n", stapel.c_str(), mikrosekunden);
+    }
+    std::fclose(bericht);
+    std::fclose(folded);
+    std::fprintf(stderr, "[gerlang] Profil geschrieben: %s.txt, %s.folded\n", basis.c_str(), basis.c_str());
+}
@@ -0,0 +1,1327 @@
+#include "analyzer.h"
+#include "konstant.h"
+
+static bool istArrayTyp(const std::string& typName) {       // Prüft, ob ein GerLang-Typ ein Array ist (KISTE oder "...[]").
+    return typName == "KISTE" || (typName.size() > 2 && typName.compare(typName.size() - 2, 2, "[]") == 0);
+}
+
+static bool istKartenTyp(const std::string& typName) {      // KARTE<K,V>, aber kein Array von Karten.
+    return typName.rfind("KARTE<", 0) == 0 && typName.back() == '>';
+}
+
+bool erkenneZaehlschleife(ForStatement* fs, Zaehlschleife& ergebnis) {     // Erkennt eine gezählte Schleife mit Schrittweite 1 und liefert Variable, Start und Ende.
+    auto vd = dynamic_cast<VariableDeclaration*>(fs->initializer.get());
+    auto as = dynamic_cast<AssignmentStatement*>(fs->initializer.get());
+    if (vd != nullptr && vd->typName == "GANZ") {
+        ergebnis.variable = vd->name;
+        ergebnis.start = vd->initializer.get();
+    } else if (as != nullptr) {
+        ergebnis.variable = as->name;
+        ergebnis.start = as->wert.get();
+    } else {
+        return false;
+    }
+
+    auto bedingung = dynamic_cast<BinaryExpression*>(fs->condition.get());
+    if (bedingung == nullptr || (bedingung->op != "<" && bedingung->op != "<=")) return false;
+    auto links = dynamic_cast<IdentifierExpression*>(bedingung->links.get());
+    if (links == nullptr || links->name != ergebnis.variable) return false;
+    ergebnis.ende = bedingung->rechts.get();
+    ergebnis.inklusiv = (bedingung->op == "<=");
+
+    auto inkrement = dynamic_cast<AssignmentStatement*>(fs->increment.get());
+    if (inkrement == nullptr || inkrement->name != ergebnis.variable) return false;
+    auto plus = dynamic_cast<BinaryExpression*>(inkrement->wert.get());
+    if (plus == nullptr || plus->op != "+") return false;
+    auto var = dynamic_cast<IdentifierExpression*>(plus->links.get());
+    auto eins = dynamic_cast<LiteralExpression*>(plus->rechts.get());
+    return var != nullptr && var->name == ergebnis.variable &&
+           eins != nullptr && eins->typName == "GANZ" && std::any_cast<int>(eins->wert) == 1;
+}
+
+bool istSeiteneffektfrei(Expression* expr) {        // Prüft, ob ein Ausdruck ohne Nebenwirkungen mehrfach ausgewertet werden darf (Literale, Variablen, Arithmetik, LAENGE).
+    if (dynamic_cast<LiteralExpression*>(expr) || dynamic_cast<IdentifierExpression*>(expr)) {
+        return true;
+    }
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        return istSeiteneffektfrei(be->links.get()) && istSeiteneffektfrei(be->rechts.get());
+    }
+    if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        return istSeiteneffektfrei(ue->rechts.get());
+    }
+    if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        return ie->name == "LAENGE" && istSeiteneffektfrei(ie->argumente[0].get());
+    }
+    return false;
+}
+
+AnalyseErgebnis Analyzer::analysiere(Program* program) {        // Läuft einmal über den AST und sammelt Informationen für den Generator.
+    for (auto& stmt : program->statements) {
+        auto sd = dynamic_cast<StrukturDeclaration*>(stmt.get());
+        if (sd != nullptr && !sd->kompakt) {
+            m_spaltenStrukturen.insert(sd->name);
+            for (auto& [typ, feld] : sd->felder) {
+                if (typ == "JAIN") m_jainSpalten[sd->name].insert(feld);
+            }
+        }
+        auto vd = dynamic_cast<VariableDeclaration*>(stmt.get());
+        if (vd != nullptr) m_globaleTypen[vd->name] = vd->typName;
+        if (vd != nullptr && istKartenTyp(vd->typName)) m_globaleKarten.insert(vd->name);
+    }
+    bestimmeReinheit(program);
+    for (auto& stmt : program->statements) {
+        if (auto fd = dynamic_cast<FunctionDeclaration*>(stmt.get())) {
+            if (fd->merke) {
+                pruefeMerke(fd);
+            }
+            analysiereFunktion(fd);
+        }
+    }
+    bestimmeConstexpr(program);
+    findeKonstanteAufrufe(program);
+    return m_ergebnis;
+}
+
+// Was eine Funktion direkt tut: erster Grund für Unreinheit, aufgerufene Funktionen und verwendete Namen.
+struct FunktionsInfo {
+    std::string grund;
+    std::set<std::string> aufrufe;
+    std::set<std::string> lokale;
+    std::set<std::string> gelesen;
+    std::set<std::string> geschrieben;
+};
+
+static void sammleAusdruck(Expression* expr, FunktionsInfo& info);
+
+static void sammleStatement(Statement* stmt, FunktionsInfo& info) {       // Sammelt die direkten Wirkungen eines Statements.
+    if (stmt == nullptr) return;
+
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        for (auto& s : bs->statements) {
+            sammleStatement(s.get(), info);
+        }
+    } else if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        info.lokale.insert(vd->name);
+        sammleAusdruck(vd->initializer.get(), info);
+    } else if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        info.geschrieben.insert(as->name);
+        sammleAusdruck(as->wert.get(), info);
+    } else if (auto aas = dynamic_cast<ArrayAssignmentStatement*>(stmt)) {
+        info.geschrieben.insert(aas->name);
+        sammleAusdruck(aas->index.get(), info);
+        sammleAusdruck(aas->wert.get(), info);
+    } else if (auto fz = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        info.geschrieben.insert(fz->name);
+        sammleAusdruck(fz->index.get(), info);
+        sammleAusdruck(fz->wert.get(), info);
+    } else if (auto ps = dynamic_cast<PrintStatement*>(stmt)) {
+        if (info.grund.empty()) info.grund = ps->datei ? "sie benutzt DATEI_SCHREIBE" : "sie benutzt DRUCKE";
+        sammleAusdruck(ps->datei.get(), info);
+        sammleAusdruck(ps->expression.get(), info);
+    } else if (dynamic_cast<FlushStatement*>(stmt)) {
+        if (info.grund.empty()) info.grund = "sie benutzt LEERE";
+    } else if (auto is = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        if (auto ziel = dynamic_cast<IdentifierExpression*>(is->aufruf->argumente[0].get())) {
+            info.geschrieben.insert(ziel->name);
+        }
+        sammleAusdruck(is->aufruf.get(), info);
+    } else if (auto rs = dynamic_cast<ReturnStatement*>(stmt)) {
+        sammleAusdruck(rs->wert.get(), info);
+    } else if (auto is = dynamic_cast<IfStatement*>(stmt)) {
+        sammleAusdruck(is->condition.get(), info);
+        sammleStatement(is->thenBranch.get(), info);
+        sammleStatement(is->elseBranch.get(), info);
+    } else if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        sammleAusdruck(ws->condition.get(), info);
+        sammleStatement(ws->body.get(), info);
+    } else if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        sammleStatement(fs->initializer.get(), info);
+        sammleAusdruck(fs->condition.get(), info);
+        sammleStatement(fs->increment.get(), info);
+        sammleStatement(fs->body.get(), info);
+    } else if (auto js = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        info.lokale.insert(js->name);
+        sammleAusdruck(js->liste.get(), info);
+        sammleStatement(js->body.get(), info);
+    }
+}
+
+static void sammleAusdruck(Expression* expr, FunktionsInfo& info) {       // Sammelt die direkten Wirkungen eines Ausdrucks.
+    if (expr == nullptr) return;
+
+    if (auto ie = dynamic_cast<IdentifierExpression*>(expr)) {
+        info.gelesen.insert(ie->name);
+    } else if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        sammleAusdruck(be->links.get(), info);
+        sammleAusdruck(be->rechts.get(), info);
+    } else if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        sammleAusdruck(ue->rechts.get(), info);
+    } else if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        if (auto name = dynamic_cast<IdentifierExpression*>(ce->aufrufer.get())) {
+            info.aufrufe.insert(name->name);
+        } else {
+            sammleAusdruck(ce->aufrufer.get(), info);
+        }
+        for (auto& arg : ce->argumente) {
+            sammleAusdruck(arg.get(), info);
+        }
+    } else if (auto al = dynamic_cast<ArrayLiteralExpression*>(expr)) {
+        for (auto& element : al->elemente) {
+            sammleAusdruck(element.get(), info);
+        }
+    } else if (auto kl = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        for (size_t i = 0; i < kl->schluessel.size(); ++i) {
+            sammleAusdruck(kl->schluessel[i].get(), info);
+            sammleAusdruck(kl->werte[i].get(), info);
+        }
+    } else if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) {
+        sammleAusdruck(aa->array.get(), info);
+        sammleAusdruck(aa->index.get(), info);
+    } else if (auto le = dynamic_cast<LeseExpression*>(expr)) {
+        if (info.grund.empty()) info.grund = "sie benutzt LESE";
+        sammleAusdruck(le->quelle.get(), info);
+    } else if (dynamic_cast<LeseAlleExpression*>(expr)) {
+        if (info.grund.empty()) info.grund = "sie benutzt LESE_ALLE";
+    } else if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        if (info.grund.empty() && ie->name.rfind("DATEI_", 0) == 0) info.grund = "sie benutzt " + ie->name;
+        for (auto& arg : ie->argumente) {
+            sammleAusdruck(arg.get(), info);
+        }
+    } else if (auto ae = dynamic_cast<AufgabeExpression*>(expr)) {
+        sammleAusdruck(ae->aufruf.get(), info);
+    } else if (auto we = dynamic_cast<WarteExpression*>(expr)) {
+        sammleAusdruck(we->aufgabe.get(), info);
+    } else if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) {
+        sammleAusdruck(tce->expression.get(), info);
+    } else if (auto fe = dynamic_cast<FeldzugriffExpression*>(expr)) {
+        sammleAusdruck(fe->objekt.get(), info);
+    }
+}
+
+void Analyzer::bestimmeReinheit(Program* program) {        // Bestimmt für jede Funktion, ob sie rein ist. Unreinheit breitet sich über Aufrufe aus, bis sich nichts mehr ändert.
+    std::map<std::string, FunktionsInfo> infos;
+    std::set<std::string> globale;
+    for (auto& stmt : program->statements) {
+        if (auto fd = dynamic_cast<FunctionDeclaration*>(stmt.get())) {
+            FunktionsInfo& info = infos[fd->name];
+            for (auto& param : fd->parameter) {
+                info.lokale.insert(param.second);
+            }
+            sammleStatement(fd->body.get(), info);
+        } else if (auto vd = dynamic_cast<VariableDeclaration*>(stmt.get())) {
+            globale.insert(vd->name);
+        } else if (auto sd = dynamic_cast<StrukturDeclaration*>(stmt.get())) {
+            infos[sd->name];    // Name(...) baut nur einen Wert und ist rein.
+        } else if (auto id = dynamic_cast<ImportDeclaration*>(stmt.get())) {
+            for (auto& name : id->namen) {
+                auto grund = id->unreineFunktionen.find(name);
+                if (grund != id->unreineFunktionen.end()) {
+                    infos[name].grund = grund->second + " (in " + id->modul + ")";
+                } else {
+                    infos[name];
+                }
+            }
+        }
+    }
+
+    // Bis hier steht in `grund` nur Ein-/Ausgabe oder die Unreinheit einer importierten Funktion.
+    for (auto& [name, info] : infos) {
+        if (!info.grund.empty()) m_nebenwirkungen[name] = info.grund;
+    }
+    m_einAusgabe = m_nebenwirkungen;
+
+    // Globale Variablen, die irgendwo verändert werden, machen jede Funktion unrein, die sie benutzt.
+    std::set<std::string> veraenderlich;
+    for (auto& [name, info] : infos) {
+        for (auto& variable : info.geschrieben) {
+            if (globale.count(variable) && !info.lokale.count(variable)) veraenderlich.insert(variable);
+        }
+    }
+    for (auto& [name, info] : infos) {
+        if (!info.grund.empty()) continue;
+        for (auto& variable : info.gelesen) {
+            if (veraenderlich.count(variable) && !info.lokale.count(variable)) {
+                info.grund = "sie liest die veränderliche globale Variable '" + variable + "'";
+                break;
+            }
+        }
+        for (auto& variable : info.geschrieben) {
+            if (info.grund.empty() && globale.count(variable) && !info.lokale.count(variable)) {
+                info.grund = "sie verändert die globale Variable '" + variable + "'";
+            }
+        }
+    }
+
+    // Welche globalen Variablen eine Funktion verändert, auch über aufgerufene Funktionen (für FUER JEDES).
+    for (auto& [name, info] : infos) {
+        for (auto& variable : info.geschrieben) {
+            if (globale.count(variable) && !info.lokale.count(variable)) {
+                m_globalGeschrieben[name].insert(variable);
+                m_nebenwirkungen.emplace(name, "sie verändert die globale Variable '" + variable + "'");
+            }
+        }
+    }
+    bool geaendert = true;
+    while (geaendert) {
+        geaendert = false;
+        for (auto& [name, info] : infos) {
+            for (auto& ziel : info.aufrufe) {
+                auto wirkung = m_nebenwirkungen.find(ziel);
+                if (wirkung != m_nebenwirkungen.end() && !m_nebenwirkungen.count(name)) {
+                    m_nebenwirkungen[name] = "über '" + ziel + "': " + wirkung->second;
+                    geaendert = true;
+                }
+                auto ea = m_einAusgabe.find(ziel);
+                if (ea != m_einAusgabe.end() && !m_einAusgabe.count(name)) {
+                    m_einAusgabe[name] = "über '" + ziel + "': " + ea->second;
+                    geaendert = true;
+                }
+                auto it = m_globalGeschrieben.find(ziel);
+                if (it == m_globalGeschrieben.end() || ziel == name) continue;
+                auto& eigene = m_globalGeschrieben[name];
+                auto vorher = eigene.size();
+                eigene.insert(it->second.begin(), it->second.end());
+                geaendert |= eigene.size() != vorher;
+            }
+        }
+    }
+
+    geaendert = true;
+    while (geaendert) {
+        geaendert = false;
+        for (auto& [name, info] : infos) {
+            if (!info.grund.empty()) continue;
+            for (auto& ziel : info.aufrufe) {
+                auto it = infos.find(ziel);
+                if (it == infos.end()) {
+                    info.grund = "sie ruft die unbekannte Funktion '" + ziel + "' auf";
+                } else if (!it->second.grund.empty()) {
+                    info.grund = "sie ruft die unreine Funktion '" + ziel + "' auf";
+                } else {
+                    continue;
+                }
+                geaendert = true;
+                break;
+            }
+        }
+    }
+
+    for (auto& [name, info] : infos) {
+        if (!info.grund.empty()) m_ergebnis.unreineFunktionen[name] = info.grund;
+    }
+}
+
+void Analyzer::pruefeMerke(FunctionDeclaration* fd) {       // MERKE setzt eine reine Funktion mit einfachen Parametern voraus, sonst wäre das gespeicherte Ergebnis falsch.
+    if (fd->name == "haupt") {
+        throw SemanticError("'haupt' kann nicht mit MERKE markiert werden");
+    }
+    auto grund = m_ergebnis.unreineFunktionen.find(fd->name);
+    if (grund != m_ergebnis.unreineFunktionen.end()) {
+        throw SemanticError("Funktion '" + fd->name + "' ist mit MERKE markiert, aber nicht rein: " + grund->second);
+    }
+    for (auto& param : fd->parameter) {
+        if (param.first != "GANZ" && param.first != "KOMMA" && param.first != "JAIN" && param.first != "WORT") {
+            throw SemanticError("MERKE-Funktion '" + fd->name + "': Parameter '" + param.second + "' hat den Typ " + param.first +
+                                ", erlaubt sind nur GANZ, KOMMA, JAIN und WORT");
+        }
+    }
+}
+
+static bool istSkalarTyp(const std::string& typName) {      // GANZ, KOMMA und JAIN: die Typen, mit denen g++ beim Kompilieren rechnen kann.
+    return typName == "GANZ" || typName == "KOMMA" || typName == "JAIN";
+}
+
+static std::string constexprGrund(Expression* expr, const std::set<std::string>& lokale, std::set<std::string>& aufrufe) {       // Erster Grund, warum ein Ausdruck nicht in eine constexpr-Funktion passt; leer, wenn er passt. Aufgerufene Funktionen landen in `aufrufe`.
+    if (expr == nullptr) return "";
+
+    if (auto le = dynamic_cast<LiteralExpression*>(expr)) {
+        return le->typName == "WORT" ? "sie benutzt WORT" : "";
+    }
+    if (auto ie = dynamic_cast<IdentifierExpression*>(expr)) {
+        return lokale.count(ie->name) ? "" : "sie liest die globale Variable '" + ie->name + "'";
+    }
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        std::string grund = constexprGrund(be->links.get(), lokale, aufrufe);
+        return grund.empty() ? constexprGrund(be->rechts.get(), lokale, aufrufe) : grund;
+    }
+    if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        return constexprGrund(ue->rechts.get(), lokale, aufrufe);
+    }
+    if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        auto name = dynamic_cast<IdentifierExpression*>(ce->aufrufer.get());
+        if (name == nullptr) return "sie ruft eine Funktion indirekt auf";
+        aufrufe.insert(name->name);
+        for (auto& arg : ce->argumente) {
+            std::string grund = constexprGrund(arg.get(), lokale, aufrufe);
+            if (!grund.empty()) return grund;
+        }
+        return "";
+    }
+    if (dynamic_cast<ArrayLiteralExpression*>(expr) || dynamic_cast<ArrayAccessExpression*>(expr)) {
+        return "sie benutzt Arrays";
+    }
+    if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        return "sie benutzt " + ie->name;
+    }
+    if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) {
+        return "sie benutzt ZU_" + tce->zielTyp;
+    }
+    if (dynamic_cast<FeldzugriffExpression*>(expr)) return "sie benutzt STRUKTUR-Felder";
+    if (dynamic_cast<KartenLiteralExpression*>(expr)) return "sie benutzt KARTE";
+    if (dynamic_cast<AufgabeExpression*>(expr)) return "sie benutzt AUFGABE";
+    if (dynamic_cast<WarteExpression*>(expr)) return "sie benutzt WARTE";
+    return "sie liest die Eingabe";
+}
+
+static std::string constexprGrund(Statement* stmt, std::set<std::string>& lokale, std::set<std::string>& aufrufe) {      // Wie oben für Statements. `lokale` wächst mit jeder Deklaration; Blöcke arbeiten auf einer Kopie.
+    if (stmt == nullptr) return "";
+
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        std::set<std::string> innen = lokale;
+        for (auto& s : bs->statements) {
+            std::string grund = constexprGrund(s.get(), innen, aufrufe);
+            if (!grund.empty()) return grund;
+        }
+        return "";
+    }
+    if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        if (!istSkalarTyp(vd->typName)) return "die lokale Variable '" + vd->name + "' hat den Typ " + vd->typName;
+        std::string grund = constexprGrund(vd->initializer.get(), lokale, aufrufe);
+        lokale.insert(vd->name);
+        return grund;
+    }
+    if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        if (!lokale.count(as->name)) return "sie verändert die globale Variable '" + as->name + "'";
+        return constexprGrund(as->wert.get(), lokale, aufrufe);
+    }
+    if (auto rs = dynamic_cast<ReturnStatement*>(stmt)) {
+        return constexprGrund(rs->wert.get(), lokale, aufrufe);
+    }
+    if (auto is = dynamic_cast<IfStatement*>(stmt)) {
+        std::string grund = constexprGrund(is->condition.get(), lokale, aufrufe);
+        if (grund.empty()) grund = constexprGrund(is->thenBranch.get(), lokale, aufrufe);
+        if (grund.empty()) grund = constexprGrund(is->elseBranch.get(), lokale, aufrufe);
+        return grund;
+    }
+    if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        std::string grund = constexprGrund(ws->condition.get(), lokale, aufrufe);
+        return grund.empty() ? constexprGrund(ws->body.get(), lokale, aufrufe) : grund;
+    }
+    if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        if (fs->parallel) return "sie benutzt PARALLEL FUER";
+        std::set<std::string> innen = lokale;
+        std::string grund = constexprGrund(fs->initializer.get(), innen, aufrufe);
+        if (grund.empty()) grund = constexprGrund(fs->condition.get(), innen, aufrufe);
+        if (grund.empty()) grund = constexprGrund(fs->increment.get(), innen, aufrufe);
+        if (grund.empty()) grund = constexprGrund(fs->body.get(), innen, aufrufe);
+        return grund;
+    }
+    if (dynamic_cast<ArrayAssignmentStatement*>(stmt) || dynamic_cast<FuerJedesStatement*>(stmt)) return "sie benutzt Arrays";
+    if (dynamic_cast<FeldZuweisungStatement*>(stmt)) return "sie benutzt STRUKTUR-Felder";
+    if (auto is = dynamic_cast<IntrinsicStatement*>(stmt)) return "sie benutzt " + is->aufruf->name;
+    if (auto ps = dynamic_cast<PrintStatement*>(stmt)) return ps->datei ? "sie benutzt DATEI_SCHREIBE" : "sie benutzt DRUCKE";
+    return "sie benutzt LEERE";
+}
+
+void Analyzer::bestimmeConstexpr(Program* program) {        // Bestimmt die Funktionen, die als constexpr generiert werden. Wie bei der Reinheit fällt eine Funktion heraus, sobald eine aufgerufene herausfällt.
+    std::map<std::string, std::set<std::string>> aufrufe;
+    for (auto& stmt : program->statements) {
+        auto fd = dynamic_cast<FunctionDeclaration*>(stmt.get());
+        if (fd == nullptr || fd->name == "haupt") continue;
+
+        std::string grund;
+        auto unrein = m_ergebnis.unreineFunktionen.find(fd->name);
+        if (unrein != m_ergebnis.unreineFunktionen.end()) {
+            grund = "nicht rein: " + unrein->second;
+        } else if (fd->merke) {
+            grund = "sie ist mit MERKE markiert";
+        } else if (!istSkalarTyp(fd->returnTyp)) {
+            grund = "sie gibt " + fd->returnTyp + " zurück";
+        }
+        std::set<std::string> lokale;
+        for (auto& param : fd->parameter) {
+            if (grund.empty() && !istSkalarTyp(param.first)) {
+                grund = "der Parameter '" + param.second + "' hat den Typ " + param.first;
+            }
+            lokale.insert(param.second);
+        }
+        if (grund.empty()) grund = constexprGrund(fd->body.get(), lokale, aufrufe[fd->name]);
+
+        if (grund.empty()) {
+            m_constexprDeklarationen[fd->name] = fd;
+        } else {
+            m_ergebnis.keinConstexpr[fd->name] = grund;
+        }
+    }
+
+    bool geaendert = true;
+    while (geaendert) {
+        geaendert = false;
+        for (auto it = m_constexprDeklarationen.begin(); it != m_constexprDeklarationen.end();) {
+            std::string grund;
+            for (auto& ziel : aufrufe[it->first]) {
+                if (!m_constexprDeklarationen.count(ziel)) {
+                    grund = "sie ruft '" + ziel + "' auf, das nicht constexpr ist";
+                    break;
+                }
+            }
+            if (grund.empty()) {
+                ++it;
+                continue;
+            }
+            m_ergebnis.keinConstexpr[it->first] = grund;
+            it = m_constexprDeklarationen.erase(it);
+            geaendert = true;
+        }
+    }
+
+    for (auto& [name, fd] : m_constexprDeklarationen) {
+        m_ergebnis.constexprFunktionen.insert(name);
+    }
+}
+
+void Analyzer::findeKonstanteAufrufe(Program* program) {        // Sucht Aufrufe von constexpr-Funktionen mit konstanten Argumenten. Die Funktion muss vor der Deklaration stehen, die den Aufruf enthält, sonst kennt g++ ihren Körper noch nicht.
+    if (m_constexprDeklarationen.empty()) return;
+
+    KonstantAuswerter auswerter(m_constexprDeklarationen);
+    m_auswerter = &auswerter;
+    for (std::size_t i = 0; i < program->statements.size(); ++i) {
+        if (auto fd = dynamic_cast<FunctionDeclaration*>(program->statements[i].get())) {
+            m_definiertBei.emplace(fd->name, i);
+        }
+    }
+    for (m_abschnitt = 0; m_abschnitt < program->statements.size(); ++m_abschnitt) {
+        falteStatement(program->statements[m_abschnitt].get());
+    }
+    m_auswerter = nullptr;
+}
+
+bool Analyzer::istKonstant(Expression* expr) {      // Literale (außer WORT) und Operatoren und constexpr-Aufrufe darüber.
+    if (auto le = dynamic_cast<LiteralExpression*>(expr)) {
+        return le->typName != "WORT";
+    }
+    if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        return istKonstant(ue->rechts.get());
+    }
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        return istKonstant(be->links.get()) && istKonstant(be->rechts.get());
+    }
+    if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        auto name = dynamic_cast<IdentifierExpression*>(ce->aufrufer.get());
+        if (name == nullptr || !m_constexprDeklarationen.count(name->name)) return false;
+        for (auto& arg : ce->argumente) {
+            if (!istKonstant(arg.get())) return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+void Analyzer::falteStatement(Statement* stmt) {        // Durchläuft ein Statement und faltet die Aufrufe in seinen Ausdrücken.
+    if (stmt == nullptr) return;
+
+    if (auto fd = dynamic_cast<FunctionDeclaration*>(stmt)) {
+        falteStatement(fd->body.get());
+    } else if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        for (auto& s : bs->statements) {
+            falteStatement(s.get());
+        }
+    } else if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        falteAusdruck(vd->initializer.get());
+    } else if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        falteAusdruck(as->wert.get());
+    } else if (auto aas = dynamic_cast<ArrayAssignmentStatement*>(stmt)) {
+        falteAusdruck(aas->index.get());
+        falteAusdruck(aas->wert.get());
+    } else if (auto fz = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        falteAusdruck(fz->index.get());
+        falteAusdruck(fz->wert.get());
+    } else if (auto ps = dynamic_cast<PrintStatement*>(stmt)) {
+        falteAusdruck(ps->datei.get());
+        falteAusdruck(ps->expression.get());
+    } else if (auto is = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        falteAusdruck(is->aufruf.get());
+    } else if (auto rs = dynamic_cast<ReturnStatement*>(stmt)) {
+        falteAusdruck(rs->wert.get());
+    } else if (auto is = dynamic_cast<IfStatement*>(stmt)) {
+        falteAusdruck(is->condition.get());
+        falteStatement(is->thenBranch.get());
+        falteStatement(is->elseBranch.get());
+    } else if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        falteAusdruck(ws->condition.get());
+        falteStatement(ws->body.get());
+    } else if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        falteStatement(fs->initializer.get());
+        falteAusdruck(fs->condition.get());
+        falteStatement(fs->increment.get());
+        falteStatement(fs->body.get());
+    } else if (auto js = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        falteAusdruck(js->liste.get());
+        falteStatement(js->body.get());
+    }
+}
+
+void Analyzer::falteAusdruck(Expression* expr) {        // Ein gefalteter Aufruf enthält seine Argumente schon; nur nicht gefaltete werden weiter durchsucht.
+    if (expr == nullptr) return;
+
+    if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        auto name = dynamic_cast<IdentifierExpression*>(ce->aufrufer.get());
+        if (name != nullptr && istKonstant(ce)) {
+            std::string grund;
+            if (m_definiertBei[name->name] >= m_abschnitt) {
+                grund = "'" + name->name + "' steht nicht vor dem Aufruf";
+            } else {
+                grund = m_auswerter->pruefe(ce);
+            }
+            if (grund.empty()) {
+                m_ergebnis.konstanteAufrufe.insert(ce);
+                return;
+            }
+            m_ergebnis.laufzeitAufrufe[ce] = grund;
+        }
+        for (auto& arg : ce->argumente) {
+            falteAusdruck(arg.get());
+        }
+    } else if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        falteAusdruck(be->links.get());
+        falteAusdruck(be->rechts.get());
+    } else if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        falteAusdruck(ue->rechts.get());
+    } else if (auto al = dynamic_cast<ArrayLiteralExpression*>(expr)) {
+        for (auto& element : al->elemente) {
+            falteAusdruck(element.get());
+        }
+    } else if (auto kl = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        for (size_t i = 0; i < kl->schluessel.size(); ++i) {
+            falteAusdruck(kl->schluessel[i].get());
+            falteAusdruck(kl->werte[i].get());
+        }
+    } else if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) {
+        falteAusdruck(aa->array.get());
+        falteAusdruck(aa->index.get());
+    } else if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        for (auto& arg : ie->argumente) {
+            falteAusdruck(arg.get());
+        }
+    } else if (auto ae = dynamic_cast<AufgabeExpression*>(expr)) {
+        for (auto& arg : ae->aufruf->argumente) {
+            falteAusdruck(arg.get());
+        }
+    } else if (auto we = dynamic_cast<WarteExpression*>(expr)) {
+        falteAusdruck(we->aufgabe.get());
+    } else if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) {
+        falteAusdruck(tce->expression.get());
+    } else if (auto fe = dynamic_cast<FeldzugriffExpression*>(expr)) {
+        falteAusdruck(fe->objekt.get());
+    }
+}
+
+void Analyzer::analysiereFunktion(FunctionDeclaration* fd) {        // Analysiert eine Funktion. Ein Array-Literal darf auf den Stack, wenn das Array nie als Ganzes neu zugewiesen, zurückgegeben, an eine Funktion übergeben oder mit HINZUFUEGEN verlängert wird.
+    m_arrayKandidaten.clear();
+    m_heapArrays.clear();
+    m_karten = m_globaleKarten;
+    m_typen = m_globaleTypen;
+    m_lokale.clear();
+    for (auto& [typ, name] : fd->parameter) {
+        m_typen[name] = typ;
+        m_lokale.insert(name);
+        if (istKartenTyp(typ)) {
+            m_karten.insert(name);
+        } else {
+            m_karten.erase(name);
+        }
+    }
+
+    analysiereStatement(fd->body.get());
+
+    for (auto& [name, deklarationen] : m_arrayKandidaten) {
+        if (deklarationen.size() != 1 || m_heapArrays.count(name)) {
+            continue;
+        }
+        m_ergebnis.festeArrays.insert(deklarationen[0]);
+    }
+}
+
+void Analyzer::analysiereStatement(Statement* stmt) {       // Durchläuft ein Statement rekursiv.
+    if (stmt == nullptr) return;
+
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        auto typen = m_typen;
+        auto lokale = m_lokale;
+        for (auto& s : bs->statements) {
+            analysiereStatement(s.get());
+        }
+        m_typen = std::move(typen);
+        m_lokale = std::move(lokale);
+    } else if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        m_typen[vd->name] = vd->typName;
+        m_lokale.insert(vd->name);
+        auto al = dynamic_cast<ArrayLiteralExpression*>(vd->initializer.get());
+        bool spalten = m_spaltenStrukturen.count(vd->typName.substr(0, vd->typName.size() - 2)) > 0;
+        if (istArrayTyp(vd->typName) && al != nullptr && !al->elemente.empty() && !spalten) {
+            m_arrayKandidaten[vd->name].push_back(vd);
+        } else if (istArrayTyp(vd->typName)) {
+            m_heapArrays.insert(vd->name);
+        }
+        if (istKartenTyp(vd->typName)) {
+            m_karten.insert(vd->name);
+        } else {
+            m_karten.erase(vd->name);
+        }
+        merkeArrayWert(vd->initializer.get());
+        analysiereAusdruck(vd->initializer.get());
+    } else if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        m_heapArrays.insert(as->name);
+        merkeArrayWert(as->wert.get());
+        analysiereAusdruck(as->wert.get());
+    } else if (auto aas = dynamic_cast<ArrayAssignmentStatement*>(stmt)) {
+        merkeArrayWert(aas->wert.get());
+        analysiereAusdruck(aas->index.get());
+        analysiereAusdruck(aas->wert.get());
+    } else if (auto fz = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        merkeArrayWert(fz->wert.get());
+        analysiereAusdruck(fz->index.get());
+        analysiereAusdruck(fz->wert.get());
+    } else if (auto ps = dynamic_cast<PrintStatement*>(stmt)) {
+        analysiereAusdruck(ps->datei.get());
+        analysiereAusdruck(ps->expression.get());
+    } else if (auto is = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        if (is->aufruf->name == "HINZUFUEGEN") {
+            auto ie = dynamic_cast<IdentifierExpression*>(is->aufruf->argumente[0].get());
+            if (ie == nullptr) {
+                throw SemanticError("HINZUFUEGEN erwartet als erstes Argument eine Array-Variable");
+            }
+            m_heapArrays.insert(ie->name);
+        }
+        analysiereAusdruck(is->aufruf.get());
+    } else if (auto rs = dynamic_cast<ReturnStatement*>(stmt)) {
+        if (auto ie = dynamic_cast<IdentifierExpression*>(rs->wert.get())) {
+            m_heapArrays.insert(ie->name);
+        }
+        analysiereAusdruck(rs->wert.get());
+    } else if (auto is = dynamic_cast<IfStatement*>(stmt)) {
+        analysiereAusdruck(is->condition.get());
+        analysiereStatement(is->thenBranch.get());
+        analysiereStatement(is->elseBranch.get());
+    } else if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        analysiereAusdruck(ws->condition.get());
+        analysiereStatement(ws->body.get());
+    } else if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        if (fs->parallel) {
+            pruefeParallel(fs);
+        } else {
+            pruefeVektor(fs);
+        }
+        auto typen = m_typen;
+        auto lokale = m_lokale;
+        analysiereStatement(fs->initializer.get());
+        analysiereAusdruck(fs->condition.get());
+        analysiereStatement(fs->increment.get());
+        analysiereStatement(fs->body.get());
+        m_typen = std::move(typen);
+        m_lokale = std::move(lokale);
+    } else if (auto js = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        pruefeJedes(js);
+        analysiereAusdruck(js->liste.get());
+        auto typen = m_typen;
+        auto lokale = m_lokale;
+        m_typen[js->name] = js->typName;
+        m_lokale.insert(js->name);
+        analysiereStatement(js->body.get());
+        m_typen = std::move(typen);
+        m_lokale = std::move(lokale);
+    }
+}
+
+void Analyzer::merkeArrayWert(Expression* wert) {      // Ein Array, das als Ganzes in eine andere Variable, einen KARTE-Eintrag oder ein Feld kopiert wird, muss ein std::vector bleiben.
+    auto ie = dynamic_cast<IdentifierExpression*>(wert);
+    if (ie == nullptr) return;
+    auto typ = m_typen.find(ie->name);
+    if (typ != m_typen.end() && istArrayTyp(typ->second)) m_heapArrays.insert(ie->name);
+}
+
+void Analyzer::analysiereAusdruck(Expression* expr) {       // Durchläuft einen Ausdruck rekursiv. Arrays, die als Argument übergeben werden, bleiben auf dem Heap.
+    if (expr == nullptr) return;
+
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        analysiereAusdruck(be->links.get());
+        analysiereAusdruck(be->rechts.get());
+    } else if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        analysiereAusdruck(ue->rechts.get());
+    } else if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        for (auto& arg : ce->argumente) {
+            if (auto ie = dynamic_cast<IdentifierExpression*>(arg.get())) {
+                m_heapArrays.insert(ie->name);
+            }
+            analysiereAusdruck(arg.get());
+        }
+    } else if (auto al = dynamic_cast<ArrayLiteralExpression*>(expr)) {
+        for (auto& element : al->elemente) {
+            analysiereAusdruck(element.get());
+        }
+    } else if (auto kl = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        for (size_t i = 0; i < kl->schluessel.size(); ++i) {
+            analysiereAusdruck(kl->schluessel[i].get());
+            analysiereAusdruck(kl->werte[i].get());
+        }
+    } else if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) {
+        analysiereAusdruck(aa->array.get());
+        analysiereAusdruck(aa->index.get());
+    } else if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        auto liste = ie->name == "SUMME" ? dynamic_cast<IdentifierExpression*>(ie->argumente[0].get()) : nullptr;
+        auto typ = liste != nullptr ? m_typen.find(liste->name) : m_typen.end();
+        if (typ != m_typen.end() && typ->second != "GANZ[]" && typ->second != "KOMMA[]" && typ->second != "KISTE") {
+            throw SemanticError("Zeile " + std::to_string(ie->zeile) + ": SUMME erwartet ein GANZ[] oder KOMMA[], '" +
+                                liste->name + "' ist vom Typ " + typ->second);
+        }
+        for (auto& arg : ie->argumente) {
+            analysiereAusdruck(arg.get());
+        }
+    } else if (auto ae = dynamic_cast<AufgabeExpression*>(expr)) {
+        // Ausgabepuffer und Dateischreiber sind nicht gesperrt; eine Aufgabe läuft neben dem Aufrufer.
+        auto name = dynamic_cast<IdentifierExpression*>(ae->aufruf->aufrufer.get());
+        auto grund = name != nullptr ? m_einAusgabe.find(name->name) : m_einAusgabe.end();
+        if (grund != m_einAusgabe.end()) {
+            throw SemanticError("Zeile " + std::to_string(ae->zeile) + ": AUFGABE: Die Funktion '" + name->name +
+                                "' darf keine Ein-/Ausgabe machen: " + grund->second);
+        }
+        analysiereAusdruck(ae->aufruf.get());
+    } else if (auto we = dynamic_cast<WarteExpression*>(expr)) {
+        analysiereAusdruck(we->aufgabe.get());
+    } else if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) {
+        analysiereAusdruck(tce->expression.get());
+    } else if (auto fe = dynamic_cast<FeldzugriffExpression*>(expr)) {
+        analysiereAusdruck(fe->objekt.get());
+    }
+}
+
+static bool verwendetVariable(Expression* expr, const std::string& name);
+
+static bool verwendetVariable(const std::vector<std::unique_ptr<Expression>>& ausdruecke, const std::string& name) {
+    for (auto& e : ausdruecke) {
+        if (verwendetVariable(e.get(), name)) return true;
+    }
+    return false;
+}
+
+static bool verwendetVariable(Expression* expr, const std::string& name) {       // Prüft, ob ein Ausdruck die Variable `name` liest.
+    if (expr == nullptr) return false;
+    if (auto ie = dynamic_cast<IdentifierExpression*>(expr)) return ie->name == name;
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        return verwendetVariable(be->links.get(), name) || verwendetVariable(be->rechts.get(), name);
+    }
+    if (auto ue = dynamic_cast<UnaryExpression*>(expr)) return verwendetVariable(ue->rechts.get(), name);
+    if (auto ce = dynamic_cast<CallExpression*>(expr)) return verwendetVariable(ce->argumente, name);
+    if (auto al = dynamic_cast<ArrayLiteralExpression*>(expr)) return verwendetVariable(al->elemente, name);
+    if (auto kl = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        return verwendetVariable(kl->schluessel, name) || verwendetVariable(kl->werte, name);
+    }
+    if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) {
+        return verwendetVariable(aa->array.get(), name) || verwendetVariable(aa->index.get(), name);
+    }
+    if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) return verwendetVariable(ie->argumente, name);
+    if (auto ae = dynamic_cast<AufgabeExpression*>(expr)) return verwendetVariable(ae->aufruf.get(), name);
+    if (auto we = dynamic_cast<WarteExpression*>(expr)) return verwendetVariable(we->aufgabe.get(), name);
+    if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) return verwendetVariable(tce->expression.get(), name);
+    if (auto fe = dynamic_cast<FeldzugriffExpression*>(expr)) return verwendetVariable(fe->objekt.get(), name);
+    if (auto le = dynamic_cast<LeseExpression*>(expr)) return verwendetVariable(le->quelle.get(), name);
+    return false;
+}
+
+static bool liestEingabe(Expression* expr) {        // Prüft, ob ein Ausdruck LESE() oder LESE_ALLE() enthält.
+    if (expr == nullptr) return false;
+    if (dynamic_cast<LeseExpression*>(expr) || dynamic_cast<LeseAlleExpression*>(expr)) return true;
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) return liestEingabe(be->links.get()) || liestEingabe(be->rechts.get());
+    if (auto ue = dynamic_cast<UnaryExpression*>(expr)) return liestEingabe(ue->rechts.get());
+    if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        for (auto& arg : ce->argumente) if (liestEingabe(arg.get())) return true;
+    }
+    if (auto al = dynamic_cast<ArrayLiteralExpression*>(expr)) {
+        for (auto& e : al->elemente) if (liestEingabe(e.get())) return true;
+    }
+    if (auto kl = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        for (auto& e : kl->schluessel) if (liestEingabe(e.get())) return true;
+        for (auto& e : kl->werte) if (liestEingabe(e.get())) return true;
+    }
+    if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) return liestEingabe(aa->array.get()) || liestEingabe(aa->index.get());
+    if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        for (auto& arg : ie->argumente) if (liestEingabe(arg.get())) return true;
+    }
+    if (auto ae = dynamic_cast<AufgabeExpression*>(expr)) return liestEingabe(ae->aufruf.get());
+    if (auto we = dynamic_cast<WarteExpression*>(expr)) return liestEingabe(we->aufgabe.get());
+    if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) return liestEingabe(tce->expression.get());
+    if (auto fe = dynamic_cast<FeldzugriffExpression*>(expr)) return liestEingabe(fe->objekt.get());
+    return false;
+}
+
+void Analyzer::pruefeParallel(ForStatement* fs) {       // Prüft den Körper einer PARALLEL FUER-Schleife auf Schreibzugriffe, die zwischen Threads kollidieren würden.
+    auto vd = static_cast<VariableDeclaration*>(fs->initializer.get());
+    if (!fs->reduktion.empty()) {
+        std::string ort = "Zeile " + std::to_string(fs->zeile) + ": PARALLEL FUER: ";
+        auto typ = m_typen.find(fs->reduktion);
+        if (typ == m_typen.end()) {
+            throw SemanticError(ort + "Die SUMME-Variable '" + fs->reduktion + "' ist nicht deklariert");
+        }
+        if (typ->second != "GANZ" && typ->second != "KOMMA") {
+            throw SemanticError(ort + "Die SUMME-Variable '" + fs->reduktion + "' ist vom Typ " + typ->second + ", erlaubt sind GANZ und KOMMA");
+        }
+    }
+    std::set<std::string> lokale = {vd->name};
+    pruefeParallelStatement(fs->body.get(), fs, lokale);
+}
+
+void Analyzer::pruefeParallelStatement(Statement* stmt, ForStatement* fs, std::set<std::string> lokale) {     // Durchläuft den Körper einer PARALLEL FUER-Schleife. `lokale` enthält die Variablen, die pro Durchlauf existieren.
+    if (stmt == nullptr) return;
+    std::string ort = "Zeile " + std::to_string(fs->zeile) + ": PARALLEL FUER: ";
+    const std::string& schleifenVariable = static_cast<VariableDeclaration*>(fs->initializer.get())->name;
+
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        for (auto& s : bs->statements) {
+            if (auto vd = dynamic_cast<VariableDeclaration*>(s.get())) {
+                pruefeParallelAusdruck(vd->initializer.get(), fs);
+                lokale.insert(vd->name);
+            } else {
+                pruefeParallelStatement(s.get(), fs, lokale);
+            }
+        }
+    } else if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        pruefeParallelAusdruck(vd->initializer.get(), fs);
+    } else if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        if (as->name == schleifenVariable) {
+            throw SemanticError(ort + "Die Schleifenvariable '" + as->name + "' darf im Körper nicht verändert werden");
+        }
+        if (!fs->reduktion.empty() && as->name == fs->reduktion) {
+            auto plus = dynamic_cast<BinaryExpression*>(as->wert.get());
+            auto links = plus ? dynamic_cast<IdentifierExpression*>(plus->links.get()) : nullptr;
+            if (plus == nullptr || plus->op != "+" || links == nullptr || links->name != fs->reduktion ||
+                verwendetVariable(plus->rechts.get(), fs->reduktion)) {
+                throw SemanticError(ort + "Die SUMME-Variable '" + fs->reduktion + "' darf nur mit '" +
+                                    fs->reduktion + " = " + fs->reduktion + " + ...' verändert werden");
+            }
+            pruefeParallelAusdruck(plus->rechts.get(), fs);
+        } else if (!lokale.count(as->name)) {
+            throw SemanticError(ort + "Schreibzugriff auf die gemeinsame Variable '" + as->name +
+                                "'. Nur die SUMME-Variable darf außerhalb des Körpers verändert werden");
+        } else {
+            pruefeParallelAusdruck(as->wert.get(), fs);
+        }
+    } else if (auto aas = dynamic_cast<ArrayAssignmentStatement*>(stmt)) {
+        if (m_karten.count(aas->name) && !lokale.count(aas->name)) {
+            throw SemanticError(ort + "Schreibzugriff auf die gemeinsame KARTE '" + aas->name +
+                                "'. Ein neuer Schlüssel kann die Tabelle umbauen; im Körper darf eine KARTE nur gelesen werden");
+        }
+        if (!lokale.count(aas->name) && gepacktesJain(aas->name, "")) {
+            throw SemanticError(ort + "Schreibzugriff auf das gemeinsame Array '" + aas->name +
+                                "'. JAIN-Elemente liegen bitweise gepackt, benachbarte Durchläufe würden dasselbe Wort schreiben");
+        }
+        pruefeParallelAusdruck(aas->index.get(), fs);
+        pruefeParallelAusdruck(aas->wert.get(), fs);
+    } else if (auto fz = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        if ((fz->index == nullptr || m_karten.count(fz->name)) && !lokale.count(fz->name)) {
+            throw SemanticError(ort + "Schreibzugriff auf die gemeinsame Variable '" + fz->name +
+                                "'. Nur die SUMME-Variable darf außerhalb des Körpers verändert werden");
+        }
+        if (fz->index != nullptr && !lokale.count(fz->name) && gepacktesJain(fz->name, fz->feld)) {
+            throw SemanticError(ort + "Schreibzugriff auf das JAIN-Feld '" + fz->feld + "' im gemeinsamen Array '" + fz->name +
+                                "'. JAIN-Elemente liegen bitweise gepackt, benachbarte Durchläufe würden dasselbe Wort schreiben");
+        }
+        pruefeParallelAusdruck(fz->index.get(), fs);
+        pruefeParallelAusdruck(fz->wert.get(), fs);
+    } else if (auto is = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        auto ziel = dynamic_cast<IdentifierExpression*>(is->aufruf->argumente[0].get());
+        if (ziel != nullptr && !lokale.count(ziel->name)) {
+            throw SemanticError(ort + is->aufruf->name + " verändert das gemeinsame Array '" + ziel->name + "'");
+        }
+        pruefeParallelAusdruck(is->aufruf.get(), fs);
+    } else if (dynamic_cast<PrintStatement*>(stmt) || dynamic_cast<FlushStatement*>(stmt)) {
+        throw SemanticError(ort + "DRUCKE, DATEI_SCHREIBE und LEERE sind im Körper nicht erlaubt");
+    } else if (dynamic_cast<ReturnStatement*>(stmt)) {
+        throw SemanticError(ort + "ZURUECK ist im Körper nicht erlaubt");
+    } else if (auto ifs = dynamic_cast<IfStatement*>(stmt)) {
+        pruefeParallelAusdruck(ifs->condition.get(), fs);
+        pruefeParallelStatement(ifs->thenBranch.get(), fs, lokale);
+        pruefeParallelStatement(ifs->elseBranch.get(), fs, lokale);
+    } else if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        pruefeParallelAusdruck(ws->condition.get(), fs);
+        pruefeParallelStatement(ws->body.get(), fs, lokale);
+    } else if (auto inner = dynamic_cast<ForStatement*>(stmt)) {
+        if (auto vd = dynamic_cast<VariableDeclaration*>(inner->initializer.get())) {
+            pruefeParallelAusdruck(vd->initializer.get(), fs);
+            lokale.insert(vd->name);
+        } else {
+            pruefeParallelStatement(inner->initializer.get(), fs, lokale);
+        }
+        pruefeParallelAusdruck(inner->condition.get(), fs);
+        pruefeParallelStatement(inner->increment.get(), fs, lokale);
+        pruefeParallelStatement(inner->body.get(), fs, lokale);
+    } else if (auto js = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        pruefeParallelAusdruck(js->liste.get(), fs);
+        lokale.insert(js->name);
+        pruefeParallelStatement(js->body.get(), fs, lokale);
+    }
+}
+
+bool Analyzer::gepacktesJain(const std::string& name, const std::string& feld) {      // Ob ein Elementschreibzugriff auf das Array `name` (bei `feld` nur auf dieses Feld) in einem std::vector<bool> landet. Leeres `feld`: das ganze Element.
+    auto typ = m_typen.find(name);
+    if (typ == m_typen.end()) return false;
+    if (typ->second == "JAIN[]") return true;
+    if (!istArrayTyp(typ->second) || typ->second == "KISTE") return false;
+    auto jain = m_jainSpalten.find(typ->second.substr(0, typ->second.size() - 2));
+    if (jain == m_jainSpalten.end()) return false;
+    return feld.empty() || jain->second.count(feld) > 0;
+}
+
+void Analyzer::pruefeParallelAusdruck(Expression* expr, ForStatement* fs) {     // Ein Ausdruck im Körper darf weder die SUMME-Variable lesen noch von der Eingabe lesen noch eine Funktion aufrufen, die Ein-/Ausgabe macht oder globale Variablen verändert.
+    std::string ort = "Zeile " + std::to_string(fs->zeile) + ": PARALLEL FUER: ";
+    if (!fs->reduktion.empty() && verwendetVariable(expr, fs->reduktion)) {
+        throw SemanticError(ort + "Die SUMME-Variable '" + fs->reduktion + "' darf im Körper nicht gelesen werden");
+    }
+    if (liestEingabe(expr)) {
+        throw SemanticError(ort + "LESE ist im Körper nicht erlaubt");
+    }
+    FunktionsInfo info;
+    sammleAusdruck(expr, info);
+    for (auto& aufruf : info.aufrufe) {
+        auto wirkung = m_nebenwirkungen.find(aufruf);
+        if (wirkung != m_nebenwirkungen.end()) {
+            throw SemanticError(ort + "Der Aufruf von '" + aufruf + "' ist im Körper nicht erlaubt: " + wirkung->second);
+        }
+    }
+}
+
+void Analyzer::pruefeJedes(FuerJedesStatement* js) {       // Bei einer Array-Variable muss ihr Elementtyp zur Schleifenvariable passen. Der Körper darf das Array nicht verlängern oder neu zuweisen, auch nicht über eine aufgerufene Funktion, sonst liest die Schleife freigegebenen Speicher.
+    auto liste = dynamic_cast<IdentifierExpression*>(js->liste.get());
+    if (liste == nullptr) {
+        pruefeJedesStatement(js->body.get(), js, "");
+        return;
+    }
+    std::string ort = "Zeile " + std::to_string(js->zeile) + ": FUER JEDES: ";
+    auto typ = m_typen.find(liste->name);
+    if (typ != m_typen.end()) {
+        if (!istArrayTyp(typ->second)) {
+            throw SemanticError(ort + "'" + liste->name + "' ist vom Typ " + typ->second + " und kein Array");
+        }
+        std::string element = typ->second == "KISTE" ? "GANZ" : typ->second.substr(0, typ->second.size() - 2);
+        if (element != js->typName) {
+            throw SemanticError(ort + "'" + liste->name + "' enthält " + element + ", nicht " + js->typName);
+        }
+    }
+    if (!m_lokale.count(liste->name)) {
+        FunktionsInfo koerper;
+        sammleStatement(js->body.get(), koerper);
+        for (auto& aufruf : koerper.aufrufe) {
+            auto geschrieben = m_globalGeschrieben.find(aufruf);
+            if (geschrieben != m_globalGeschrieben.end() && geschrieben->second.count(liste->name)) {
+                throw SemanticError(ort + "Die Funktion '" + aufruf + "' verändert das Array '" + liste->name + "', über das die Schleife läuft");
+            }
+        }
+    }
+    pruefeJedesStatement(js->body.get(), js, liste->name);
+}
+
+void Analyzer::pruefeJedesStatement(Statement* stmt, FuerJedesStatement* js, const std::string& liste) {       // Durchläuft den Körper einer FUER JEDES-Schleife. `liste` ist das durchlaufene Array ("" bei einem anderen Ausdruck).
+    if (stmt == nullptr) return;
+    std::string ort = "Zeile " + std::to_string(js->zeile) + ": FUER JEDES: ";
+
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        for (auto& s : bs->statements) {
+            pruefeJedesStatement(s.get(), js, liste);
+        }
+    } else if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        if (as->name == js->name) {
+            throw SemanticError(ort + "Die Variable '" + js->name + "' kann im Körper nur gelesen werden");
+        }
+        if (as->name == liste) {
+            throw SemanticError(ort + "Das Array '" + liste + "' darf im Körper nicht neu zugewiesen werden");
+        }
+    } else if (auto fz = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        if (fz->name == js->name && fz->index == nullptr) {
+            throw SemanticError(ort + "Die Variable '" + js->name + "' kann im Körper nur gelesen werden");
+        }
+    } else if (auto is = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        auto ziel = dynamic_cast<IdentifierExpression*>(is->aufruf->argumente[0].get());
+        if (is->aufruf->name == "HINZUFUEGEN" && ziel != nullptr && ziel->name == liste) {
+            throw SemanticError(ort + "HINZUFUEGEN verlängert das Array '" + liste + "', über das die Schleife läuft");
+        }
+    } else if (auto ifs = dynamic_cast<IfStatement*>(stmt)) {
+        pruefeJedesStatement(ifs->thenBranch.get(), js, liste);
+        pruefeJedesStatement(ifs->elseBranch.get(), js, liste);
+    } else if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        pruefeJedesStatement(ws->body.get(), js, liste);
+    } else if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        pruefeJedesStatement(fs->initializer.get(), js, liste);
+        pruefeJedesStatement(fs->increment.get(), js, liste);
+        pruefeJedesStatement(fs->body.get(), js, liste);
+    } else if (auto inner = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        pruefeJedesStatement(inner->body.get(), js, liste);
+    }
+}
+
+namespace {
+
+// Durchläuft den Körper einer Zählschleife und sammelt alle Array-Zugriffe. Die Durchläufe sind
+// unabhängig, wenn jedes beschriebene Array in allen Durchläufen an derselben Stelle a[i + k]
+// gelesen und geschrieben wird und von außerhalb nur GANZ-Summen verändert werden.
+// Beim ersten Hindernis bricht die Prüfung mit dem Grund ab.
+class VektorPruefung {
+public:
+    struct Hindernis {
+        std::string grund;
+    };
+
+    VektorPruefung(const Zaehlschleife& schleife, const std::map<std::string, std::string>& typen,
+                   const std::map<std::string, std::string>& unreine)
+        : m_schleife(schleife), m_typen(typen), m_unreine(unreine) {}
+
+    VektorSchleife pruefe(Statement* body);
+
+private:
+    struct Lesen {
+        std::string array;
+        bool affin;             // Index der Form i + k.
+        long long versatz;      // k
+    };
+
+    const Zaehlschleife& m_schleife;
+    const std::map<std::string, std::string>& m_typen;
+    const std::map<std::string, std::string>& m_unreine;
+    VektorSchleife m_ergebnis;
+    std::map<std::string, long long> m_schreibVersatz;     // Beschriebenes Array -> k aus a[i + k].
+    std::vector<Lesen> m_gelesen;
+    std::set<std::string> m_aussenGelesen;                 // Variablen von außerhalb, die der Körper liest.
+
+    void statement(Statement* stmt, std::set<std::string> lokale);
+    void ausdruck(Expression* expr, const std::set<std::string>& lokale);
+    void array(const std::string& name, const std::set<std::string>& lokale);
+    bool affin(Expression* index, long long& versatz);
+    std::string typ(const std::string& name);
+    std::string indexText(long long versatz);
+};
+
+bool istSkalar(const std::string& typ) {
+    return typ == "GANZ" || typ == "KOMMA" || typ == "JAIN";
+}
+
+bool ganzLiteral(Expression* expr, long long& wert) {       // Eine GANZ-Konstante, auch mit Vorzeichen.
+    if (auto le = dynamic_cast<LiteralExpression*>(expr)) {
+        if (le->typName != "GANZ") return false;
+        wert = std::any_cast<int>(le->wert);
+        return true;
+    }
+    auto ue = dynamic_cast<UnaryExpression*>(expr);
+    if (ue == nullptr || ue->op != "-" || !ganzLiteral(ue->rechts.get(), wert)) return false;
+    wert = -wert;
+    return true;
+}
+
+VektorSchleife VektorPruefung::pruefe(Statement* body) {        // Liefert die Zugriffe des Körpers oder wirft den Grund, warum die Durchläufe voneinander abhängen können.
+    statement(body, {});
+    for (auto& lesen : m_gelesen) {
+        auto schreiben = m_schreibVersatz.find(lesen.array);
+        if (schreiben == m_schreibVersatz.end()) continue;
+        std::string ziel = lesen.array + "[" + indexText(schreiben->second) + "]";
+        if (!lesen.affin) {
+            throw Hindernis{"liest " + lesen.array + " an einem berechneten Index, geschrieben wird " + ziel};
+        }
+        if (lesen.versatz != schreiben->second) {
+            throw Hindernis{"liest " + lesen.array + "[" + indexText(lesen.versatz) + "], geschrieben wird " + ziel +
+                            " (ein Durchlauf liest, was ein anderer schreibt)"};
+        }
+    }
+    for (auto& summe : m_ergebnis.summen) {
+        if (m_aussenGelesen.count(summe)) {
+            throw Hindernis{"liest die Variable '" + summe + "', die im Körper aufsummiert wird"};
+        }
+        if (verwendetVariable(m_schleife.ende, summe)) {
+            throw Hindernis{"das Ende der Schleife hängt von '" + summe + "' ab, die im Körper aufsummiert wird"};
+        }
+    }
+    if (m_ergebnis.arrays.empty()) throw Hindernis{"greift auf kein Array zu"};
+    if (m_ergebnis.geschrieben.empty() && m_ergebnis.summen.empty()) throw Hindernis{"schreibt weder in ein Array noch in eine Summe"};
+    return m_ergebnis;
+}
+
+void VektorPruefung::statement(Statement* stmt, std::set<std::string> lokale) {       // `lokale` sind die im Körper deklarierten Variablen; jeder Durchlauf hat seine eigenen.
+    if (stmt == nullptr) return;
+    const std::string& i = m_schleife.variable;
+
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        for (auto& s : bs->statements) {
+            if (auto vd = dynamic_cast<VariableDeclaration*>(s.get())) {
+                if (!istSkalar(vd->typName)) {
+                    throw Hindernis{"deklariert '" + vd->name + "' vom Typ " + vd->typName};
+                }
+                ausdruck(vd->initializer.get(), lokale);
+                lokale.insert(vd->name);
+            } else {
+                statement(s.get(), lokale);
+            }
+        }
+    } else if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        if (!istSkalar(vd->typName)) throw Hindernis{"deklariert '" + vd->name + "' vom Typ " + vd->typName};
+        ausdruck(vd->initializer.get(), lokale);
+    } else if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        if (as->name == i) throw Hindernis{"verändert die Schleifenvariable '" + i + "'"};
+        if (lokale.count(as->name)) {
+            ausdruck(as->wert.get(), lokale);
+            return;
+        }
+        auto plus = dynamic_cast<BinaryExpression*>(as->wert.get());
+        auto links = plus != nullptr && plus->op == "+" ? dynamic_cast<IdentifierExpression*>(plus->links.get()) : nullptr;
+        bool summe = links != nullptr && links->name == as->name;
+        if (summe && typ(as->name) == "GANZ") {
+            m_ergebnis.summen.insert(as->name);
+            ausdruck(plus->rechts.get(), lokale);
+        } else if (summe && typ(as->name) == "KOMMA") {
+            throw Hindernis{"summiert die KOMMA-Variable '" + as->name + "'; vektorisiert würde in anderer Reihenfolge gerundet"};
+        } else {
+            throw Hindernis{"schreibt die Variable '" + as->name + "' von außerhalb der Schleife, der nächste Durchlauf hängt davon ab"};
+        }
+    } else if (auto aas = dynamic_cast<ArrayAssignmentStatement*>(stmt)) {
+        array(aas->name, lokale);
+        long long versatz = 0;
+        if (!affin(aas->index.get(), versatz)) {
+            throw Hindernis{"schreibt " + aas->name + " nicht an einem Index " + i + " + Konstante"};
+        }
+        auto bisher = m_schreibVersatz.find(aas->name);
+        if (bisher != m_schreibVersatz.end() && bisher->second != versatz) {
+            throw Hindernis{"schreibt " + aas->name + "[" + indexText(bisher->second) + "] und " + aas->name + "[" + indexText(versatz) + "]"};
+        }
+        m_schreibVersatz[aas->name] = versatz;
+        m_ergebnis.geschrieben.insert(aas->name);
+        ausdruck(aas->wert.get(), lokale);
+    } else if (auto ifs = dynamic_cast<IfStatement*>(stmt)) {
+        ausdruck(ifs->condition.get(), lokale);
+        statement(ifs->thenBranch.get(), lokale);
+        statement(ifs->elseBranch.get(), lokale);
+    } else if (auto fz = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        throw Hindernis{"schreibt ein Feld von '" + fz->name + "'"};
+    } else if (auto is = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        throw Hindernis{is->aufruf->name + " im Körper"};
+    } else if (dynamic_cast<PrintStatement*>(stmt) || dynamic_cast<FlushStatement*>(stmt)) {
+        throw Hindernis{"DRUCKE, DATEI_SCHREIBE oder LEERE im Körper"};
+    } else if (dynamic_cast<ReturnStatement*>(stmt)) {
+        throw Hindernis{"ZURUECK im Körper"};
+    } else if (dynamic_cast<WhileStatement*>(stmt)) {
+        throw Hindernis{"SOLANGE im Körper"};
+    } else if (dynamic_cast<ForStatement*>(stmt) || dynamic_cast<FuerJedesStatement*>(stmt)) {
+        throw Hindernis{"enthält eine weitere FUER-Schleife"};
+    } else {
+        throw Hindernis{"Anweisung in Zeile " + std::to_string(stmt->zeile) + " wird nicht unterstützt"};
+    }
+}
+
+void VektorPruefung::ausdruck(Expression* expr, const std::set<std::string>& lokale) {     // Erlaubt sind Zahlen, Arithmetik, Array-Elemente, LAENGE und Aufrufe reiner Funktionen.
+    if (expr == nullptr) return;
+
+    if (auto le = dynamic_cast<LiteralExpression*>(expr)) {
+        if (le->typName == "WORT") throw Hindernis{"Text im Körper"};
+    } else if (auto ie = dynamic_cast<IdentifierExpression*>(expr)) {
+        if (ie->name == m_schleife.variable || lokale.count(ie->name)) return;
+        std::string t = typ(ie->name);
+        if (!istSkalar(t)) {
+            throw Hindernis{"verwendet '" + ie->name + "' vom Typ " + (t.empty() ? "?" : t) + " als Ganzes"};
+        }
+        m_aussenGelesen.insert(ie->name);
+    } else if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        ausdruck(be->links.get(), lokale);
+        ausdruck(be->rechts.get(), lokale);
+    } else if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        ausdruck(ue->rechts.get(), lokale);
+    } else if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) {
+        if (!istSkalar(tce->zielTyp)) throw Hindernis{"Umwandlung nach " + tce->zielTyp + " im Körper"};
+        ausdruck(tce->expression.get(), lokale);
+    } else if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) {
+        auto name = dynamic_cast<IdentifierExpression*>(aa->array.get());
+        if (name == nullptr) throw Hindernis{"Zugriff mit [] auf einen berechneten Wert"};
+        array(name->name, lokale);
+        Lesen lesen{name->name, false, 0};
+        lesen.affin = affin(aa->index.get(), lesen.versatz);
+        m_gelesen.push_back(lesen);
+        ausdruck(aa->index.get(), lokale);
+    } else if (auto in = dynamic_cast<IntrinsicExpression*>(expr)) {
+        auto argument = in->argumente.empty() ? nullptr : dynamic_cast<IdentifierExpression*>(in->argumente[0].get());
+        if (in->name != "LAENGE" || argument == nullptr) throw Hindernis{in->name + " im Körper"};
+    } else if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        auto name = dynamic_cast<IdentifierExpression*>(ce->aufrufer.get());
+        if (name == nullptr) throw Hindernis{"Aufruf eines berechneten Werts"};
+        auto unrein = m_unreine.find(name->name);
+        if (unrein != m_unreine.end()) {
+            throw Hindernis{"ruft " + name->name + " auf, die nicht rein ist (" + unrein->second + ")"};
+        }
+        for (auto& arg : ce->argumente) ausdruck(arg.get(), lokale);
+    } else if (dynamic_cast<LeseExpression*>(expr) || dynamic_cast<LeseAlleExpression*>(expr)) {
+        throw Hindernis{"LESE im Körper"};
+    } else if (dynamic_cast<FeldzugriffExpression*>(expr)) {
+        throw Hindernis{"liest ein STRUKTUR-Feld"};
+    } else {
+        throw Hindernis{"Ausdruck in Zeile " + std::to_string(expr->zeile) + " wird nicht unterstützt"};
+    }
+}
+
+void VektorPruefung::array(const std::string& name, const std::set<std::string>& lokale) {     // Nur GANZ- und KOMMA-Arrays liegen als zusammenhängende Zahlen im Speicher (JAIN[] ist std::vector<bool>).
+    std::string t = lokale.count(name) ? "" : typ(name);
+    std::string element;
+    if (t == "GANZ[]" || t == "KISTE") element = "GANZ";
+    if (t == "KOMMA[]") element = "KOMMA";
+    if (element.empty()) {
+        throw Hindernis{"'" + name + "' ist vom Typ " + (t.empty() ? "?" : t) + "; nur GANZ[] und KOMMA[] werden vektorisiert"};
+    }
+    m_ergebnis.arrays[name] = element;
+}
+
+bool VektorPruefung::affin(Expression* index, long long& versatz) {        // Erkennt i, i + k, k + i und i - k mit einer Konstante k.
+    auto variable = [&](Expression* e) {
+        auto ie = dynamic_cast<IdentifierExpression*>(e);
+        return ie != nullptr && ie->name == m_schleife.variable;
+    };
+    if (variable(index)) {
+        versatz = 0;
+        return true;
+    }
+    auto be = dynamic_cast<BinaryExpression*>(index);
+    if (be == nullptr || (be->op != "+" && be->op != "-")) return false;
+    long long k = 0;
+    if (variable(be->links.get()) && ganzLiteral(be->rechts.get(), k)) {
+        versatz = be->op == "+" ? k : -k;
+        return true;
+    }
+    if (be->op == "+" && ganzLiteral(be->links.get(), k) && variable(be->rechts.get())) {
+        versatz = k;
+        return true;
+    }
+    return false;
+}
+
+std::string VektorPruefung::typ(const std::string& name) {
+    auto gefunden = m_typen.find(name);
+    return gefunden != m_typen.end() ? gefunden->second : "";
+}
+
+std::string VektorPruefung::indexText(long long versatz) {     // "i", "i + 2", "i - 1"
+    if (versatz == 0) return m_schleife.variable;
+    return m_schleife.variable + (versatz > 0 ? " + " : " - ") + std::to_string(versatz > 0 ? versatz : -versatz);
+}
+
+}
+
+void Analyzer::pruefeVektor(ForStatement* fs) {     // Eine gezählte FUER-Schleife mit unabhängigen Durchläufen kommt nach vektorSchleifen, jede andere mit dem Grund nach keineVektorSchleife (für --vektor-bericht).
+    Zaehlschleife schleife;
+    std::string grund;
+    if (!erkenneZaehlschleife(fs, schleife)) {
+        grund = "keine Zählschleife der Form FUER (GANZ i = a; i < b; i = i + 1)";
+    } else if (dynamic_cast<VariableDeclaration*>(fs->initializer.get()) == nullptr) {
+        grund = "die Schleifenvariable '" + schleife.variable + "' ist außerhalb der Schleife deklariert";
+    } else if (!istSeiteneffektfrei(schleife.ende) || verwendetVariable(schleife.ende, schleife.variable)) {
+        grund = "das Ende der Schleife steht nicht vor dem ersten Durchlauf fest";
+    } else {
+        try {
+            VektorSchleife vektor = VektorPruefung(schleife, m_typen, m_ergebnis.unreineFunktionen).pruefe(fs->body.get());
+            m_ergebnis.vektorSchleifen[fs] = std::move(vektor);
+            return;
+        } catch (const VektorPruefung::Hindernis& h) {
+            grund = h.grund;
+        }
+    }
+    m_ergebnis.keineVektorSchleife[fs] = grund;
+}
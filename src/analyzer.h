@@ -0,0 +1,103 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "ast.h"
+
+class KonstantAuswerter;
+
+class SemanticError : public std::runtime_error {
+public:
+    SemanticError(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Eine FUER-Schleife, deren Durchläufe nicht voneinander abhängen: Der Generator setzt
+// `#pragma omp simd` davor und greift über __restrict-Zeiger auf die Arrays zu.
+struct VektorSchleife {
+    std::map<std::string, std::string> arrays;     // Arrays, auf die der Körper mit [] zugreift -> Elementtyp (GANZ oder KOMMA).
+    std::set<std::string> geschrieben;             // Davon die, in die der Körper schreibt.
+    std::set<std::string> summen;                  // GANZ-Variablen von außerhalb, die nur mit `s = s + ...` verändert werden (reduction).
+};
+
+// Ergebnis der Analyse, das der Generator beim Erzeugen des C++-Codes nutzt.
+struct AnalyseErgebnis {
+    std::set<const VariableDeclaration*> festeArrays;      // Array-Literale, deren Länge sich nie ändert (-> std::array auf dem Stack).
+    std::map<std::string, std::string> unreineFunktionen;  // Funktionsname -> Grund, warum sie nicht rein ist (alle anderen sind rein).
+    std::set<std::string> constexprFunktionen;              // Reine Funktionen, die g++ beim Kompilieren auswerten kann.
+    std::map<std::string, std::string> keinConstexpr;       // Alle anderen Funktionen (außer haupt) -> Grund.
+    std::set<const CallExpression*> konstanteAufrufe;       // Aufrufe mit konstanten Argumenten, die beim Kompilieren ausgewertet werden.
+    std::map<const CallExpression*, std::string> laufzeitAufrufe;   // Aufrufe mit konstanten Argumenten, die zur Laufzeit bleiben -> Grund.
+    std::map<const ForStatement*, VektorSchleife> vektorSchleifen;  // FUER-Schleifen mit unabhängigen Durchläufen.
+    std::map<const ForStatement*, std::string> keineVektorSchleife; // Alle anderen FUER-Schleifen (außer PARALLEL FUER) -> Grund.
+};
+
+// Eine FUER-Schleife der Form `FUER (GANZ i = start; i < ende; i = i + 1)` (auch `<=`).
+struct Zaehlschleife {
+    std::string variable;
+    Expression* start = nullptr;
+    Expression* ende = nullptr;
+    bool inklusiv = false;
+};
+
+bool erkenneZaehlschleife(ForStatement* fs, Zaehlschleife& ergebnis);
+bool istSeiteneffektfrei(Expression* expr);
+
+class Analyzer {
+public:
+    AnalyseErgebnis analysiere(Program* program);
+
+private:
+    AnalyseErgebnis m_ergebnis;
+
+    // Pro Funktion: Array-Kandidaten und Namen, die den Stack ausschließen.
+    std::map<std::string, std::vector<VariableDeclaration*>> m_arrayKandidaten;
+    std::set<std::string> m_heapArrays;
+    std::set<std::string> m_spaltenStrukturen;     // STRUKTUR ohne KOMPAKT: Arrays davon sind Spalten-Container, kein std::array.
+    std::map<std::string, std::set<std::string>> m_jainSpalten;    // STRUKTUR ohne KOMPAKT -> JAIN-Felder (Spalten als bitweise gepackter std::vector<bool>).
+    std::set<std::string> m_globaleKarten;         // Globale Variablen vom Typ KARTE.
+    std::set<std::string> m_karten;                // KARTE-Variablen, die in der aktuellen Funktion sichtbar sind (für PARALLEL FUER).
+    std::map<std::string, std::string> m_globaleTypen;     // Globale Variablen -> Typ.
+    std::map<std::string, std::string> m_typen;            // Sichtbare Variablen an der aktuellen Stelle -> Typ (für pruefeVektor).
+    std::set<std::string> m_lokale;                        // Parameter und lokale Variablen an der aktuellen Stelle (verdecken globale).
+    std::map<std::string, std::set<std::string>> m_globalGeschrieben;  // Funktion -> globale Variablen, die sie selbst oder über Aufrufe verändert.
+    std::map<std::string, std::string> m_nebenwirkungen;   // Funktion -> Ein-/Ausgabe oder Schreibzugriff auf globale Variablen, auch über Aufrufe (für PARALLEL FUER).
+    std::map<std::string, std::string> m_einAusgabe;       // Funktion -> Ein-/Ausgabe, auch über Aufrufe (für AUFGABE).
+
+    // Reinheit: keine Ein-/Ausgabe, keine veränderlichen globalen Variablen, nur reine Funktionen aufrufen.
+    void bestimmeReinheit(Program* program);
+    void pruefeMerke(FunctionDeclaration* fd);
+
+    // constexpr: reine Funktionen über GANZ/KOMMA/JAIN ohne Arrays und Eingebautes. Ihre Aufrufe
+    // mit konstanten Argumenten faltet g++, wenn der KonstantAuswerter sie vorher geschafft hat.
+    void bestimmeConstexpr(Program* program);
+    void findeKonstanteAufrufe(Program* program);
+    void falteStatement(Statement* stmt);
+    void falteAusdruck(Expression* expr);
+    bool istKonstant(Expression* expr);
+
+    std::map<std::string, FunctionDeclaration*> m_constexprDeklarationen;
+    std::map<std::string, std::size_t> m_definiertBei;     // Funktion -> Index ihrer Top-Level-Deklaration.
+    std::size_t m_abschnitt = 0;                            // Index der Top-Level-Deklaration, die gerade gefaltet wird.
+    KonstantAuswerter* m_auswerter = nullptr;
+
+    void analysiereFunktion(FunctionDeclaration* fd);
+    void analysiereStatement(Statement* stmt);
+    void analysiereAusdruck(Expression* expr);
+    void merkeArrayWert(Expression* wert);
+
+    // PARALLEL FUER: Der Körper darf außer der SUMME-Variable keine gemeinsamen Variablen schreiben.
+    void pruefeParallel(ForStatement* fs);
+    void pruefeParallelStatement(Statement* stmt, ForStatement* fs, std::set<std::string> lokale);
+    void pruefeParallelAusdruck(Expression* expr, ForStatement* fs);
+    bool gepacktesJain(const std::string& name, const std::string& feld);
+
+    // FUER JEDES: Elementtyp passend zum Array, Elementvariable nur lesbar, Array behält seine Länge.
+    void pruefeJedes(FuerJedesStatement* js);
+    void pruefeJedesStatement(Statement* stmt, FuerJedesStatement* js, const std::string& liste);
+
+    // Abhängigkeiten zwischen den Durchläufen einer gezählten FUER-Schleife (für #pragma omp simd).
+    void pruefeVektor(ForStatement* fs);
+};
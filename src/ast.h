@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <any>
+#include <map>
 
 class Statement;
 class Expression;
@@ -80,6 +81,30 @@ public:
     std::string name;
     std::vector<std::pair<std::string, std::string>> parameter;
     std::unique_ptr<BlockStatement> body;
+    bool merke = false;         // MERKE: Ergebnisse werden pro Argument-Tupel zwischengespeichert.
+    int merkeGrenze = 0;        // Aus MERKE(n), 0 = Standardgrenze (GERLANG_MERKE_GRENZE).
+};
+
+class ImportDeclaration : public Statement {
+public:
+    std::vector<std::string> namen;     // HOLE f, g VON "mathe.gc";
+    std::string modul;                  // Pfad wie im Quelltext, relativ zur importierenden Datei.
+    // Vom Modulsystem (module.cpp) vor Analyse und Generator aufgelöst:
+    std::string header;                                     // Generierter Header des Moduls.
+    std::vector<std::string> rueckgabeTypen;                // Parallel zu `namen`.
+    std::map<std::string, std::string> unreineFunktionen;   // Importierte Namen -> Grund, warum sie nicht rein sind.
+};
+
+class StrukturDeclaration : public Statement {
+    // STRUKTUR Punkt { KOMMA x; KOMMA y; } - ein Verbund. Punkt[] speichert jedes Feld in einem eigenen Vektor.
+public:
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> felder;     // (Typ, Name) in Deklarationsreihenfolge.
+    bool kompakt = false;       // KOMPAKT STRUKTUR: Arrays als std::vector<Punkt> (ein Element nach dem anderen).
+};
+
+class FlushStatement : public Statement {
+    // LEERE(); schreibt den Ausgabepuffer sofort auf die Konsole.
 };
 
 class ReturnStatement : public Statement {
@@ -90,6 +115,7 @@ public:
 class PrintStatement : public Statement {
 public:
     std::unique_ptr<Expression> expression;
+    std::unique_ptr<Expression> datei;      // DATEI_SCHREIBE(pfad, ...): Pfad der Zieldatei; bei DRUCKE leer (std::cout).
 };
 
 class IfStatement : public Statement {
@@ -117,6 +143,17 @@ public:
     std::unique_ptr<Expression> condition;
     std::unique_ptr<Statement> increment;
     std::unique_ptr<Statement> body;
+    bool parallel = false;      // PARALLEL FUER
+    std::string reduktion;      // Variable aus SUMME(...) bei PARALLEL FUER, sonst leer.
+};
+
+class FuerJedesStatement : public Statement {
+    // FUER JEDES (GANZ x IN liste) { ... } durchläuft alle Elemente eines Arrays.
+public:
+    std::string typName;                // Typ der Elementvariable.
+    std::string name;
+    std::unique_ptr<Expression> liste;
+    std::unique_ptr<Statement> body;
 };
 
 class ArrayLiteralExpression : public Expression {
@@ -124,6 +161,13 @@ public:
     std::vector<std::unique_ptr<Expression>> elemente;
 };
 
+class KartenLiteralExpression : public Expression {
+    // {k1: v1, k2: v2} für KARTE; schluessel[i] gehört zu werte[i].
+public:
+    std::vector<std::unique_ptr<Expression>> schluessel;
+    std::vector<std::unique_ptr<Expression>> werte;
+};
+
 class ArrayAccessExpression : public Expression {
 public:
     std::unique_ptr<Expression> array;
@@ -137,8 +181,56 @@ public:
     std::unique_ptr<Expression> wert;
 };
 
+class FeldzugriffExpression : public Expression {
+    // p.x oder punkte[i].x
+public:
+    std::unique_ptr<Expression> objekt;
+    std::string feld;
+};
+
+class FeldZuweisungStatement : public Statement {
+    // p.x = wert; oder punkte[i].x = wert; (index ist dann gesetzt).
+public:
+    std::string name;
+    std::unique_ptr<Expression> index;
+    std::string feld;
+    std::unique_ptr<Expression> wert;
+};
+
 class LeseExpression : public Expression {
-    // sie dient nur als "Markierung" für den Generator.
+    // LESE() liest eine Zeile von der Standardeingabe, LESE(z) die nächste Zeile aus DATEI_ZEILEN.
+public:
+    std::unique_ptr<Expression> quelle;     // Bei LESE() leer.
+};
+
+class LeseAlleExpression : public Expression {
+    // LESE_ALLE() liest die komplette Standardeingabe als WORT[] ein.
+};
+
+class IntrinsicExpression : public Expression {
+    // Eingebaute Funktion: LAENGE(a), SUMME(a), HINZUFUEGEN(a, x), SORTIERE(a), ENTHAELT(m, k), SCHLUESSEL(m),
+    // DATEI_LESE(pfad), DATEI_ZEILEN(pfad), DATEI_ENDE(z).
+public:
+    std::string name;
+    std::vector<std::unique_ptr<Expression>> argumente;
+};
+
+class IntrinsicStatement : public Statement {
+    // Eingebaute Array-Funktion als Anweisung, z.B. HINZUFUEGEN(a, x);
+public:
+    std::unique_ptr<IntrinsicExpression> aufruf;
+};
+
+class AufgabeExpression : public Expression {
+    // AUFGABE f(x) startet den Aufruf als Task im Thread-Pool und liefert ein Handle.
+public:
+    std::unique_ptr<CallExpression> aufruf;
+};
+
+class WarteExpression : public Expression {
+    // WARTE(h) wartet auf das Ergebnis eines mit AUFGABE gestarteten Aufrufs.
+public:
+    std::unique_ptr<Expression> aufgabe;
 };
 
 class TypeConversionExpression : public Expression {
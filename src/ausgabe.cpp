@@ -0,0 +1,132 @@
+#include "ausgabe.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+
+void Ausgabe::schreibeLangsam(const char* daten, std::size_t laenge) {      // Füllt den Puffer auf und holt so lange neue, bis alles geschrieben ist.
+    while (laenge > 0) {
+        if (m_zeiger == m_ende) wechslePuffer();
+        std::size_t teil = std::min(laenge, static_cast<std::size_t>(m_ende - m_zeiger));
+        std::memcpy(m_zeiger, daten, teil);
+        m_zeiger += teil;
+        daten += teil;
+        laenge -= teil;
+    }
+}
+
+Ausgabe& Ausgabe::operator<<(float zahl) {      // Kürzeste Darstellung, die beim Einlesen wieder denselben float ergibt. Bekommt immer einen Punkt oder Exponenten, damit 2.0 in C++ kein int-Literal wird.
+    char puffer[32];
+    auto ergebnis = std::to_chars(puffer, puffer + sizeof(puffer), zahl);
+    std::size_t laenge = static_cast<std::size_t>(ergebnis.ptr - puffer);
+    schreibe(puffer, laenge);
+    if (std::isfinite(zahl) && std::string_view(puffer, laenge).find_first_of(".e") == std::string_view::npos) {
+        schreibe(".0", 2);
+    }
+    return *this;
+}
+
+SpeicherAusgabe::SpeicherAusgabe() {        // Beginnt mit einem leeren Block.
+    m_bloecke.push_back(std::make_unique<char[]>(BLOCKGROESSE));
+    m_anfang = m_zeiger = m_bloecke[0].get();
+    m_ende = m_anfang + BLOCKGROESSE;
+}
+
+void SpeicherAusgabe::neuerPuffer() {       // Nimmt den nächsten Block, falls einer aus einer früheren Runde übrig ist, sonst einen neuen.
+    ++m_aktiv;
+    if (m_aktiv == m_bloecke.size()) {
+        m_bloecke.push_back(std::make_unique<char[]>(BLOCKGROESSE));
+    }
+    m_anfang = m_zeiger = m_bloecke[m_aktiv].get();
+    m_ende = m_anfang + BLOCKGROESSE;
+}
+
+std::string SpeicherAusgabe::text() const {        // Setzt die Blöcke zu einem String zusammen.
+    std::string ergebnis;
+    ergebnis.reserve(position());
+    for (std::size_t i = 0; i < m_aktiv; ++i) {
+        ergebnis.append(m_bloecke[i].get(), BLOCKGROESSE);
+    }
+    ergebnis.append(m_anfang, static_cast<std::size_t>(m_zeiger - m_anfang));
+    return ergebnis;
+}
+
+void SpeicherAusgabe::uebertrageNach(Ausgabe& ziel) {       // Schreibt den Inhalt nach `ziel` und leert das Seil; die Blöcke bleiben für den nächsten Abschnitt.
+    for (std::size_t i = 0; i < m_aktiv; ++i) {
+        ziel.schreibe(m_bloecke[i].get(), BLOCKGROESSE);
+    }
+    ziel.schreibe(m_anfang, static_cast<std::size_t>(m_zeiger - m_anfang));
+    zuruecksetzen();
+}
+
+void SpeicherAusgabe::zuruecksetzen() {        // Leert das Seil, behält aber die Blöcke.
+    m_aktiv = 0;
+    m_abgegeben = 0;
+    m_anfang = m_zeiger = m_bloecke[0].get();
+    m_ende = m_anfang + BLOCKGROESSE;
+}
+
+DateiAusgabe::DateiAusgabe(int fd, bool schliessen)     // Übernimmt einen offenen Deskriptor; mit `schliessen` wird er im Destruktor geschlossen.
+    : m_fd(fd), m_schliessen(schliessen), m_puffer(std::make_unique<char[]>(PUFFERGROESSE)) {
+    m_anfang = m_zeiger = m_puffer.get();
+    m_ende = m_anfang + PUFFERGROESSE;
+}
+
+DateiAusgabe::DateiAusgabe(const std::string& pfad)       // Legt die Datei beim ersten Schreiben an bzw. überschreibt sie.
+    : DateiAusgabe(-1, true) {
+    m_pfad = pfad;
+}
+
+DateiAusgabe::~DateiAusgabe() {
+    leere();
+    if (m_schliessen && m_fd >= 0) ::close(m_fd);
+}
+
+bool DateiAusgabe::leere() {        // Schreibt den Puffer sofort; false, wenn bisher ein Schreibfehler aufgetreten ist (auch, wenn sich das Ziel nicht öffnen ließ).
+    wechslePuffer();
+    return !m_fehler;
+}
+
+void DateiAusgabe::oeffne() {       // Öffnet das Ziel beim ersten Schreiben.
+    if (!m_pfad.empty()) m_fd = ::open(m_pfad.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) m_fehler = true;
+}
+
+void DateiAusgabe::neuerPuffer() {      // Schreibt den vollen Puffer und verwendet ihn danach weiter. Kurze Schreibvorgänge und EINTR werden wiederholt.
+    const char* daten = m_anfang;
+    std::size_t rest = static_cast<std::size_t>(m_zeiger - m_anfang);
+    if (rest > 0 && m_fd < 0 && !m_fehler) oeffne();
+    while (rest > 0 && !m_fehler) {
+        ssize_t geschrieben = m_fd >= 0 ? ::write(m_fd, daten, rest) : -1;
+        if (geschrieben < 0) {
+            if (errno == EINTR) continue;
+            m_fehler = true;
+            break;
+        }
+        daten += geschrieben;
+        rest -= static_cast<std::size_t>(geschrieben);
+    }
+    m_zeiger = m_anfang;
+}
+
+CompilerAusgabe::CompilerAusgabe(const std::string& befehl) : DateiAusgabe(-1), m_befehl(befehl) {}
+
+void CompilerAusgabe::oeffne() {        // Startet den Compiler. Die Signale bleiben Sache des Programms (gppc ignoriert SIGPIPE).
+    m_prozess = ::popen(m_befehl.c_str(), "w");
+    if (m_prozess != nullptr) m_fd = ::fileno(m_prozess);
+    else m_fehler = true;
+}
+
+CompilerAusgabe::~CompilerAusgabe() {
+    schliesse();
+}
+
+int CompilerAusgabe::schliesse() {      // Schreibt den Rest, schließt die Eingabe des Compilers und liefert seinen Exit-Status. Wurde nie etwas geschrieben, startet g++ nicht.
+    leere();
+    if (m_prozess == nullptr) return 1;
+    int status = ::pclose(m_prozess);
+    m_prozess = nullptr;
+    m_fd = -1;
+    return (status == 0 && !m_fehler) ? 0 : 1;
+}
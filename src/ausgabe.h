@@ -0,0 +1,136 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Ziel für den generierten C++-Code. Schreibt in einen Puffer und gibt ihn erst ab,
+// wenn er voll ist: als neuen Block im Speicher (SpeicherAusgabe), per write(2) in
+// eine Datei (DateiAusgabe) oder direkt an g++ (CompilerAusgabe).
+// Zahlen werden mit std::to_chars formatiert, unabhängig von der Locale.
+class Ausgabe {
+public:
+    Ausgabe() = default;
+    Ausgabe(const Ausgabe&) = delete;
+    Ausgabe& operator=(const Ausgabe&) = delete;
+    virtual ~Ausgabe() = default;
+
+    void schreibe(const char* daten, std::size_t laenge) {
+        if (laenge <= static_cast<std::size_t>(m_ende - m_zeiger)) {
+            std::memcpy(m_zeiger, daten, laenge);
+            m_zeiger += laenge;
+        } else {
+            schreibeLangsam(daten, laenge);
+        }
+    }
+
+    Ausgabe& operator<<(std::string_view text) {
+        schreibe(text.data(), text.size());
+        return *this;
+    }
+
+    Ausgabe& operator<<(char c) {
+        if (m_zeiger == m_ende) wechslePuffer();
+        *m_zeiger++ = c;
+        return *this;
+    }
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>, int> = 0>
+    Ausgabe& operator<<(T zahl) {
+        char puffer[24];
+        auto ergebnis = std::to_chars(puffer, puffer + sizeof(puffer), zahl);
+        schreibe(puffer, static_cast<std::size_t>(ergebnis.ptr - puffer));
+        return *this;
+    }
+
+    Ausgabe& operator<<(float zahl);
+
+    // Anzahl der bisher geschriebenen Bytes (wie tellp bei einem stringstream).
+    std::size_t position() const { return m_abgegeben + static_cast<std::size_t>(m_zeiger - m_anfang); }
+
+protected:
+    char* m_anfang = nullptr;
+    char* m_zeiger = nullptr;
+    char* m_ende = nullptr;
+    std::size_t m_abgegeben = 0;        // Bytes in bereits abgegebenen Puffern.
+
+    // Gibt den vollen Puffer [m_anfang, m_zeiger) ab und setzt einen freien Puffer.
+    virtual void neuerPuffer() = 0;
+
+    void wechslePuffer() {
+        m_abgegeben += static_cast<std::size_t>(m_zeiger - m_anfang);
+        neuerPuffer();
+    }
+
+private:
+    void schreibeLangsam(const char* daten, std::size_t laenge);
+};
+
+// Seil aus Blöcken fester Größe. Beim Wachsen wird nichts umkopiert, und nach
+// uebertrageNach() werden die Blöcke wiederverwendet.
+class SpeicherAusgabe : public Ausgabe {
+public:
+    static constexpr std::size_t BLOCKGROESSE = 64 * 1024;
+
+    SpeicherAusgabe();
+
+    std::string text() const;
+    void uebertrageNach(Ausgabe& ziel);
+    void zuruecksetzen();
+
+protected:
+    void neuerPuffer() override;
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_bloecke;
+    std::size_t m_aktiv = 0;            // Index des Blocks, in den gerade geschrieben wird; alle davor sind voll.
+};
+
+// Gepufferte Ausgabe direkt auf einen Dateideskriptor. Eine Datei (bzw. bei CompilerAusgabe
+// der Compiler) wird erst geöffnet, wenn der erste Puffer voll ist oder geleert wird: Bricht
+// die Übersetzung vorher ab, bleibt eine alte Datei unverändert und g++ startet gar nicht.
+class DateiAusgabe : public Ausgabe {
+public:
+    static constexpr std::size_t PUFFERGROESSE = 256 * 1024;
+
+    explicit DateiAusgabe(int fd, bool schliessen = false);
+    explicit DateiAusgabe(const std::string& pfad);
+    ~DateiAusgabe() override;
+
+    bool leere();
+
+protected:
+    int m_fd;
+    bool m_schliessen;
+    bool m_fehler = false;
+
+    void neuerPuffer() override;
+    virtual void oeffne();
+
+private:
+    std::unique_ptr<char[]> m_puffer;
+    std::string m_pfad;         // Bei DateiAusgabe(pfad): die Datei, die oeffne() anlegt.
+};
+
+// Schreibt in die Standardeingabe eines Compileraufrufs (`g++ -x c++ - ...`), ohne
+// temporäre .cpp-Datei. Bricht der Compiler früh ab, beendet SIGPIPE das Programm,
+// wenn es das Signal nicht selbst ignoriert; dann liefert schliesse() einen Fehler.
+class CompilerAusgabe : public DateiAusgabe {
+public:
+    explicit CompilerAusgabe(const std::string& befehl);
+    ~CompilerAusgabe() override;
+
+    int schliesse();            // Wartet auf den Compiler; 0 bei Erfolg.
+
+protected:
+    void oeffne() override;
+
+private:
+    std::string m_befehl;
+    std::FILE* m_prozess = nullptr;
+};
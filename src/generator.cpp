@@ -1,34 +1,104 @@
 #include "generator.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
-std::string gerlang_lese() {    // Liest eine Zeile von der Standardeingabe (Konsole).
-    std::string line;
-    std::getline(std::cin, line);
-    return line;
+Generator::Generator(std::unique_ptr<Program> program, AnalyseErgebnis analyse, GeneratorOptionen optionen)      // Konstruktor: Nimmt den vom Parser erzeugten AST, das Ergebnis der Analyse und die Optionen entgegen.
+    : m_program(std::move(program)), m_analyse(std::move(analyse)), m_optionen(optionen) {}
+
+Generator::Generator(const Generator& haupt)
+    : m_analyse(haupt.m_analyse), m_optionen(haupt.m_optionen), m_funktionsTypen(haupt.m_funktionsTypen), m_strukturen(haupt.m_strukturen), m_worte(haupt.m_worte) {}
+
+void Generator::generate(Ausgabe& ziel) {       // Startet den Generierungsprozess und schreibt den fertigen C++-Code nach `ziel`. Bindet die Laufzeitbibliothek (runtime/gerlang.h) ein.
+    if (m_optionen.profil) {
+        // Der Bericht steht vor dem Programm, damit er vor allen globalen Variablen angelegt und nach ihnen geschrieben wird.
+        // Die Messstellen sind erst nach dem Programm bekannt; als Konstanten sind sie trotzdem schon beim Anlegen initialisiert.
+        ziel << "#include \"gerlang.h\"\n#include \"gerlang_profil.h\"\n\n"
+             << "extern const GerlangProfilOrt gerlang_profil_orte[];\n"
+             << "extern const int gerlang_profil_anzahl;\n"
+             << "static GerlangProfilBericht gerlang_profil_bericht(gerlang_profil_orte, gerlang_profil_anzahl);\n\n";
+    } else {
+        ziel << "#include \"gerlang.h\"\n\n";
+    }
+    visitProgram(m_program.get(), ziel);
+    if (m_optionen.profil) {
+        profilTabelle(ziel);
+    }
 }
 
-Generator::Generator(std::unique_ptr<Program> program)      // Konstruktor: Nimmt den vom Parser erzeugten AST entgegen.
-    : m_program(std::move(program)) {}
+std::string Generator::generate() {         // Wie generate(Ausgabe&), aber liefert den Code als String (für Module und PGO, die ihn hashen).
+    SpeicherAusgabe ziel;
+    generate(ziel);
+    return ziel.text();
+}
 
-std::string Generator::generate() {         // Startet den Generierungsprozess und gibt den fertigen C++-Code als String zurück. Fügt Standard-Includes und Helper-Funktionen hinzu.
-    m_output << "#include <iostream>\n";
-    m_output << "#include <string>\n\n";
-    m_output << "#include <vector>\n\n";
+std::string Generator::schnittstelle() {      // Erzeugt den Header eines Moduls: die STRUKTUR-Typen und Prototypen der exportierten Funktionen. Bei MERKE ist das die Hülle mit dem Cache.
+    std::stringstream header;
+    header << "#pragma once\n#include \"gerlang.h\"\n\n";
+    for (auto& stmt : m_program->statements) {
+        if (auto sd = dynamic_cast<StrukturDeclaration*>(stmt.get())) {
+            m_strukturen[sd->name] = sd;
+            header << strukturCode(sd);
+        }
+    }
+    for (auto& stmt : m_program->statements) {
+        auto fd = dynamic_cast<FunctionDeclaration*>(stmt.get());
+        if (fd == nullptr || !m_optionen.exportiert.count(fd->name)) continue;
+        header << mapType(fd->returnTyp) << " " << fd->name << "(";
+        for (size_t i = 0; i < fd->parameter.size(); ++i) {
+            header << (i > 0 ? ", " : "") << mapType(fd->parameter[i].first) << " " << fd->parameter[i].second;
+        }
+        header << ");\n";
+    }
+    return header.str();
+}
 
-    m_output << "std::string gerlang_lese() {\n";
-    m_output << "    std::string line;\n";
-    m_output << "    std::getline(std::cin, line);\n";
-    m_output << "    return line;\n";
-    m_output << "}\n\n";
+void Generator::profilTabelle(Ausgabe& ziel) {       // Erzeugt die Tabelle der Messstellen, die der Bericht am Programmende auswertet.
+    ziel << "const GerlangProfilOrt gerlang_profil_orte[] = {\n";
+    for (auto& [name, zeile] : m_profilTabelle) {
+        ziel << "    {\"" << name << "\", " << zeile << "},\n";
+    }
+    if (m_profilTabelle.empty()) {
+        ziel << "    {\"\", 0},\n";
+    }
+    ziel << "};\n";
+    ziel << "const int gerlang_profil_anzahl = " << m_profilTabelle.size() << ";\n";
+}
 
-    m_output << "int gerlang_zu_ganz(std::string s) { try { return std::stoi(s); } catch(...) { return 0; } }\n";   // Wandelt einen String in eine Ganzzahl um (mit Fehlerbehandlung).
-    m_output << "float gerlang_zu_komma(std::string s) { try { return std::stof(s); } catch(...) { return 0.0; } }\n";  // Wandelt einen String in eine Kommazahl um (mit Fehlerbehandlung).
-    m_output << "std::string gerlang_zu_wort(auto s) { return std::to_string(s); }\n\n";    // Wandelt verschiedene Typen (Zahlen etc.) in einen String um.
-    
-    visitProgram(m_program.get());
-    
-    return m_output.str();
+bool Generator::beginneSchleifenMessung(const std::string& name, int zeile) {     // --profile-schleifen: Öffnet einen Block mit einem Messpunkt um die folgende Schleife. Der Aufrufer schließt ihn, wenn true zurückkommt.
+    if (!m_optionen.profilSchleifen) return false;
+    m_profilOrte.push_back({name, zeile});
+    m_output << "    {\n    GerlangProfilMessung gerlang_messung(" << m_profilBasis + m_profilOrte.size() - 1 << ");\n";
+    return true;
+}
+
+static bool zerlegeKarte(const std::string& typ, std::string& schluessel, std::string& wert) {     // Zerlegt "KARTE<WORT,GANZ>" in Schlüssel- und Werttyp. Der Schlüssel ist immer ein einfacher Typ ohne Komma.
+    if (typ.rfind("KARTE<", 0) != 0 || typ.back() != '>') return false;
+    std::size_t komma = typ.find(',');
+    schluessel = typ.substr(6, komma - 6);
+    wert = typ.substr(komma + 1, typ.size() - komma - 2);
+    return true;
+}
+
+static bool istKarte(const std::string& typ) {
+    std::string schluessel, wert;
+    return zerlegeKarte(typ, schluessel, wert);
+}
+
+static bool gleicherSchluessel(Expression* a, Expression* b) {      // Derselbe Variablenname oder dasselbe GANZ-/WORT-Literal: beide Seiten von `m[k] = m[k] + x` treffen denselben Eintrag.
+    auto ia = dynamic_cast<IdentifierExpression*>(a);
+    auto ib = dynamic_cast<IdentifierExpression*>(b);
+    if (ia != nullptr && ib != nullptr) return ia->name == ib->name;
+    auto la = dynamic_cast<LiteralExpression*>(a);
+    auto lb = dynamic_cast<LiteralExpression*>(b);
+    if (la == nullptr || lb == nullptr || la->typName != lb->typName) return false;
+    if (la->typName == "GANZ") return std::any_cast<int>(la->wert) == std::any_cast<int>(lb->wert);
+    if (la->typName == "WORT") return std::any_cast<std::string>(la->wert) == std::any_cast<std::string>(lb->wert);
+    return false;
 }
 
 std::string Generator::mapType(const std::string& gerlangType) {        // Übersetzt GerLang-Typnamen (z.B. "GANZ[]") in C++-Typnamen (z.B. "std::vector<int>").
@@ -36,14 +106,84 @@ std::string Generator::mapType(const std::string& gerlangType) {        // Über
     if (gerlangType == "WORT") return "std::string";
     if (gerlangType == "JAIN") return "bool";
     if (gerlangType == "KOMMA") return "float";
+    if (gerlangType == "SICHT") return "std::string_view";
+    if (gerlangType == "ZEILEN") return "GerlangZeilen";
     if (gerlangType == "KISTE") return "std::vector<int>";
     if (gerlangType == "GANZ[]") return "std::vector<int>";
     if (gerlangType == "WORT[]") return "std::vector<std::string>";
     if (gerlangType == "JAIN[]") return "std::vector<bool>";
     if (gerlangType == "KOMMA[]") return "std::vector<float>";
+    if (gerlangType.rfind("AUFGABE<", 0) == 0) {
+        return "GerlangAufgabe<" + mapType(gerlangType.substr(8, gerlangType.size() - 9)) + ">";
+    }
+    std::string schluessel, wert;
+    if (zerlegeKarte(gerlangType, schluessel, wert)) {
+        return "GerlangKarte<" + mapType(schluessel) + ", " + mapType(wert) + ">";
+    }
+    if (m_strukturen.count(gerlangType)) return gerlangType;
+    std::string element = elementTyp(gerlangType);
+    if (m_strukturen.count(element)) {
+        return istSpaltenArray(gerlangType) ? "gerlang_spalten_" + element : "std::vector<" + element + ">";
+    }
+    if (!element.empty()) return "std::vector<" + mapType(element) + ">";
     return "void";
 }
 
+bool Generator::istSpaltenArray(const std::string& typ) {      // Ein Array einer STRUKTUR ohne KOMPAKT: eine Spalte (std::vector) pro Feld.
+    auto gefunden = m_strukturen.find(elementTyp(typ));
+    return gefunden != m_strukturen.end() && !gefunden->second->kompakt;
+}
+
+std::string Generator::feldTyp(const std::string& strukturTyp, const std::string& feld) {       // GerLang-Typ eines Felds; "" bei unbekannter STRUKTUR oder unbekanntem Feld.
+    auto gefunden = m_strukturen.find(strukturTyp);
+    if (gefunden == m_strukturen.end()) return "";
+    for (auto& [typ, name] : gefunden->second->felder) {
+        if (name == feld) return typ;
+    }
+    return "";
+}
+
+std::string Generator::elementTyp(const std::string& arrayTyp) {        // Liefert den GerLang-Elementtyp eines Array-Typs (z.B. "WORT[]" -> "WORT", "KISTE" -> "GANZ").
+    if (arrayTyp == "KISTE") return "GANZ";
+    if (arrayTyp.size() > 2 && arrayTyp.compare(arrayTyp.size() - 2, 2, "[]") == 0) {
+        return arrayTyp.substr(0, arrayTyp.size() - 2);
+    }
+    return "";
+}
+
+static std::string cppText(const std::string& text) {        // Schreibt einen WORT-Wert als C++-Stringliteral. Anführungszeichen, Backslashes und Steuerzeichen werden maskiert, alle anderen Bytes (auch UTF-8) bleiben wie sie sind.
+    static const char* ziffern = "01234567";
+    std::string ergebnis = "\"";
+    for (char c : text) {
+        unsigned char b = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            ergebnis += '\\';
+            ergebnis += c;
+        } else if (c == '\n') {
+            ergebnis += "\\n";
+        } else if (c == '\t') {
+            ergebnis += "\\t";
+        } else if (b < 0x20 || b == 0x7F) {      // Oktal mit drei Ziffern, damit eine folgende Ziffer nicht zur Escape-Sequenz gehört.
+            ergebnis += '\\';
+            ergebnis += ziffern[b >> 6];
+            ergebnis += ziffern[(b >> 3) & 7];
+            ergebnis += ziffern[b & 7];
+        } else {
+            ergebnis += c;
+        }
+    }
+    return ergebnis + "\"";
+}
+
+static bool istWortLiteral(Expression* expr) {
+    auto le = dynamic_cast<LiteralExpression*>(expr);
+    return le != nullptr && le->typName == "WORT";
+}
+
+static bool istVergleich(const std::string& op) {
+    return op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=";
+}
+
 std::string mapOperator(const std::string& op) {        // Übersetzt GerLang-Operatoren (z.B. "UND") in C++-Operatoren (z.B. "&&").
     if (op == "UND") return "&&";
     if (op == "ODER") return "||";
@@ -51,13 +191,28 @@ std::string mapOperator(const std::string& op) {        // Übersetzt GerLang-Op
     return op;
 }
 
+void Generator::markiereZeile(Statement* stmt) {       // Schreibt `#line N "datei.gc"` vor ein Statement, damit Compilerfehler, gdb, perf und Sanitizer auf die .gc-Zeile zeigen.
+    if (m_optionen.quellDatei.empty() || dynamic_cast<BlockStatement*>(stmt)) return;
+    m_output << "#line " << stmt->zeile << " \"";
+    for (char c : m_optionen.quellDatei) {
+        if (c == '\\' || c == '"') m_output << '\\';
+        m_output << c;
+    }
+    m_output << "\"\n";
+}
+
 void Generator::visit(Statement* stmt) {        // Verteilerfunktion: Leitet den Aufruf an die passende `visit...`-Funktion für den konkreten Statement-Typ weiter.
+    markiereZeile(stmt);
     if (auto s = dynamic_cast<FunctionDeclaration*>(stmt)) {
         visitFunctionDeclaration(s);
     } else if (auto s = dynamic_cast<BlockStatement*>(stmt)) {
         visitBlockStatement(s);
     } else if (auto s = dynamic_cast<PrintStatement*>(stmt)) {
         visitPrintStatement(s);
+    } else if (auto s = dynamic_cast<FlushStatement*>(stmt)) {
+        visitFlushStatement(s);
+    } else if (auto s = dynamic_cast<ImportDeclaration*>(stmt)) {
+        visitImportDeclaration(s);
     } else if (auto s = dynamic_cast<ReturnStatement*>(stmt)) {
         visitReturnStatement(s);
     } else if (auto s = dynamic_cast<IfStatement*>(stmt)) {
@@ -68,10 +223,18 @@ void Generator::visit(Statement* stmt) {        // Verteilerfunktion: Leitet den
         visitAssignmentStatement(s);
     } else if (auto s = dynamic_cast<WhileStatement*>(stmt)) {
         visitWhileStatement(s);
+    } else if (auto s = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        visitFuerJedesStatement(s);
     } else if (auto s = dynamic_cast<ForStatement*>(stmt)) {
         visitForStatement(s);
     } else if (auto s = dynamic_cast<ArrayAssignmentStatement*>(stmt)) {
         visitArrayAssignmentStatement(s);
+    } else if (auto s = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        visitFeldZuweisungStatement(s);
+    } else if (auto s = dynamic_cast<StrukturDeclaration*>(stmt)) {
+        visitStrukturDeclaration(s);
+    } else if (auto s = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        visitIntrinsicStatement(s);
     } else {
         std::cerr << "Generator Fehler: Unbekannter Statement-Typ!" << std::endl;
     }
@@ -90,30 +253,288 @@ void Generator::visit(Expression* expr) {       // Verteilerfunktion: Leitet den
         visitCallExpression(e);
     } else if (auto e = dynamic_cast<ArrayLiteralExpression*>(expr)) {
         visitArrayLiteralExpression(e);
+    } else if (auto e = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        visitKartenLiteralExpression(e);
     } else if (auto e = dynamic_cast<ArrayAccessExpression*>(expr)) {
         visitArrayAccessExpression(e);
+    } else if (auto e = dynamic_cast<FeldzugriffExpression*>(expr)) {
+        visitFeldzugriffExpression(e);
     } else if (auto e = dynamic_cast<LeseExpression*>(expr)) {
         visitLeseExpression(e);
+    } else if (auto e = dynamic_cast<LeseAlleExpression*>(expr)) {
+        visitLeseAlleExpression(e);
     } else if (auto e = dynamic_cast<TypeConversionExpression*>(expr)) {
         visitTypeConversionExpression(e);
+    } else if (auto e = dynamic_cast<IntrinsicExpression*>(expr)) {
+        visitIntrinsicExpression(e);
+    } else if (auto e = dynamic_cast<AufgabeExpression*>(expr)) {
+        visitAufgabeExpression(e);
+    } else if (auto e = dynamic_cast<WarteExpression*>(expr)) {
+        visitWarteExpression(e);
     } else {
          std::cerr << "Generator Fehler: Unbekannter Expression-Typ!" << std::endl;
     }
 }
 
-void Generator::visitProgram(Program* p) {      // Besucht den Wurzelknoten des AST und ruft `visit` für alle Top-Level-Statements auf.
+void Generator::visitProgram(Program* p, Ausgabe& ziel) {      // Besucht den Wurzelknoten des AST und generiert alle Top-Level-Statements, bei mehreren Threads parallel. Jeder Abschnitt wird gleich an `ziel` abgegeben, damit nie das ganze Programm im Speicher liegt.
     for (auto& stmt : p->statements) {
-        if (stmt != nullptr) {
-            visit(stmt.get());
+        if (auto fd = dynamic_cast<FunctionDeclaration*>(stmt.get())) {
+            m_funktionsTypen[fd->name] = fd->returnTyp;
+        } else if (auto id = dynamic_cast<ImportDeclaration*>(stmt.get())) {
+            for (size_t i = 0; i < id->namen.size() && i < id->rueckgabeTypen.size(); ++i) {
+                m_funktionsTypen[id->namen[i]] = id->rueckgabeTypen[i];
+            }
+        } else if (auto sd = dynamic_cast<StrukturDeclaration*>(stmt.get())) {
+            m_strukturen[sd->name] = sd;
+            m_funktionsTypen[sd->name] = sd->name;      // Punkt(...) liefert einen Punkt.
+        }
+    }
+
+    // Vorlauf: Was ein Abschnitt von den vorherigen braucht, sind nur die globalen Variablen und die Nummer seiner ersten Messstelle.
+    std::vector<Abschnitt> abschnitte;
+    auto globale = std::make_shared<const std::map<std::string, std::string>>();
+    std::size_t profilOrte = 0;
+    betreteScope();
+    for (auto& stmt : p->statements) {
+        if (stmt == nullptr) continue;
+        abschnitte.push_back({stmt.get(), globale, profilOrte});
+        profilOrte += zaehleProfilOrte(stmt.get());
+        sammleWorte(stmt.get());
+        if (auto vd = dynamic_cast<VariableDeclaration*>(stmt.get())) {
+            deklariereVariable(vd->name, vd->typName == "AUFGABE" ? ermittleTyp(vd->initializer.get()) : vd->typName);
+            globale = std::make_shared<const std::map<std::string, std::string>>(m_scopes.back());
         }
     }
+    verlasseScope();
+    worteKonstanten(ziel);
+
+    unsigned threads = m_optionen.threads > 0 ? m_optionen.threads : std::max(1u, std::thread::hardware_concurrency());
+    if (threads > 1 && abschnitte.size() > 1) {
+        generiereParallel(abschnitte, std::min<std::size_t>(threads, abschnitte.size()), ziel);
+        return;
+    }
+    for (auto& abschnitt : abschnitte) {
+        generiereAbschnitt(abschnitt);
+        m_profilTabelle.insert(m_profilTabelle.end(), m_profilOrte.begin(), m_profilOrte.end());
+        m_output.uebertrageNach(ziel);
+    }
+}
+
+void Generator::generiereAbschnitt(const Abschnitt& abschnitt) {     // Generiert eine Top-Level-Deklaration nach m_output, mit dem Zustand aus dem Vorlauf.
+    m_scopes.assign(1, *abschnitt.globale);
+    m_profilBasis = abschnitt.profilBasis;
+    m_profilOrte.clear();
+    visit(abschnitt.stmt);
+    m_scopes.clear();
+}
+
+void Generator::generiereParallel(const std::vector<Abschnitt>& abschnitte, unsigned threads, Ausgabe& ziel) {     // Verteilt die Abschnitte auf Arbeiter; der aufrufende Thread gibt die fertigen Texte in Quelltextreihenfolge aus. Die Ausgabe ist byte-gleich zum seriellen Weg.
+    struct Ergebnis {
+        std::string code;
+        std::vector<std::pair<std::string, int>> profilOrte;
+        bool fertig = false;
+    };
+    std::vector<Ergebnis> ergebnisse(abschnitte.size());
+    std::mutex mutex;
+    std::condition_variable signal;
+    std::size_t naechster = 0;
+    std::size_t ausgegeben = 0;
+    std::exception_ptr fehler;
+    const std::size_t fenster = 8 * static_cast<std::size_t>(threads);     // Höchstens so viele Abschnitte liegen fertig im Speicher.
+
+    auto arbeite = [&]() {
+        Generator arbeiter(*this);
+        for (;;) {
+            std::size_t i;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                signal.wait(lock, [&] { return fehler || naechster >= abschnitte.size() || naechster < ausgegeben + fenster; });
+                if (fehler || naechster >= abschnitte.size()) return;
+                i = naechster++;
+            }
+            Ergebnis ergebnis;
+            try {
+                arbeiter.generiereAbschnitt(abschnitte[i]);
+                ergebnis.code = arbeiter.m_output.text();
+                ergebnis.profilOrte = std::move(arbeiter.m_profilOrte);
+                arbeiter.m_output.zuruecksetzen();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                fehler = std::current_exception();
+                signal.notify_all();
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ergebnis.fertig = true;
+            ergebnisse[i] = std::move(ergebnis);
+            signal.notify_all();
+        }
+    };
+
+    std::vector<std::thread> arbeiter;
+    for (unsigned t = 0; t < threads; ++t) {
+        arbeiter.emplace_back(arbeite);
+    }
+    while (ausgegeben < abschnitte.size()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        signal.wait(lock, [&] { return fehler || ergebnisse[ausgegeben].fertig; });
+        if (fehler) break;
+        Ergebnis ergebnis = std::move(ergebnisse[ausgegeben]);
+        lock.unlock();
+        ziel << ergebnis.code;
+        m_profilTabelle.insert(m_profilTabelle.end(), ergebnis.profilOrte.begin(), ergebnis.profilOrte.end());
+        lock.lock();
+        ++ausgegeben;
+        signal.notify_all();
+    }
+    for (auto& t : arbeiter) {
+        t.join();
+    }
+    if (fehler) std::rethrow_exception(fehler);
+}
+
+std::size_t Generator::zaehleProfilOrte(Statement* stmt) {      // Zählt die Messstellen, die das Generieren von `stmt` anlegt (wie visitFunctionDeclaration und beginneSchleifenMessung).
+    if (!m_optionen.profil || stmt == nullptr) return 0;
+    if (auto fd = dynamic_cast<FunctionDeclaration*>(stmt)) {
+        return 1 + zaehleProfilOrte(fd->body.get());
+    }
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        std::size_t anzahl = 0;
+        for (auto& s : bs->statements) anzahl += zaehleProfilOrte(s.get());
+        return anzahl;
+    }
+    if (auto is = dynamic_cast<IfStatement*>(stmt)) {
+        return zaehleProfilOrte(is->thenBranch.get()) + zaehleProfilOrte(is->elseBranch.get());
+    }
+    std::size_t schleife = m_optionen.profilSchleifen ? 1 : 0;
+    if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        return schleife + zaehleProfilOrte(ws->body.get());
+    }
+    if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        return schleife + zaehleProfilOrte(fs->body.get());
+    }
+    if (auto js = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        return schleife + zaehleProfilOrte(js->body.get());
+    }
+    return 0;
+}
+
+void Generator::sammleWorte(Statement* stmt) {      // Vorlauf: Sammelt in Quelltextreihenfolge die WORT-Literale, die visitWortOperand als Konstante ausgibt. So sind die Nummern unabhängig davon, welcher Thread welchen Abschnitt generiert.
+    if (stmt == nullptr) return;
+    if (auto fd = dynamic_cast<FunctionDeclaration*>(stmt)) {
+        sammleWorte(fd->body.get());
+    } else if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        for (auto& s : bs->statements) sammleWorte(s.get());
+    } else if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        sammleWorte(vd->initializer.get());
+    } else if (auto ps = dynamic_cast<PrintStatement*>(stmt)) {
+        sammleWorte(ps->datei.get());
+        sammleDruckteile(ps->expression.get());
+    } else if (auto rs = dynamic_cast<ReturnStatement*>(stmt)) {
+        sammleWorte(rs->wert.get());
+    } else if (auto is = dynamic_cast<IfStatement*>(stmt)) {
+        sammleWorte(is->condition.get());
+        sammleWorte(is->thenBranch.get());
+        sammleWorte(is->elseBranch.get());
+    } else if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        sammleWorte(as->wert.get());
+    } else if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        sammleWorte(ws->condition.get());
+        sammleWorte(ws->body.get());
+    } else if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        sammleWorte(fs->initializer.get());
+        sammleWorte(fs->condition.get());
+        sammleWorte(fs->increment.get());
+        sammleWorte(fs->body.get());
+    } else if (auto js = dynamic_cast<FuerJedesStatement*>(stmt)) {
+        sammleWorte(js->liste.get());
+        sammleWorte(js->body.get());
+    } else if (auto aas = dynamic_cast<ArrayAssignmentStatement*>(stmt)) {
+        sammleWorte(aas->index.get());
+        sammleWorte(aas->wert.get());
+    } else if (auto fz = dynamic_cast<FeldZuweisungStatement*>(stmt)) {
+        sammleWorte(fz->index.get());
+        sammleWorte(fz->wert.get());
+    } else if (auto ist = dynamic_cast<IntrinsicStatement*>(stmt)) {
+        sammleWorte(ist->aufruf.get());
+    }
+}
+
+void Generator::sammleWorte(Expression* expr) {
+    if (expr == nullptr) return;
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        bool operand = be->op == "+" || istVergleich(be->op);
+        if (operand) merkeWort(be->links.get());
+        sammleWorte(be->links.get());
+        if (operand) merkeWort(be->rechts.get());
+        sammleWorte(be->rechts.get());
+    } else if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        sammleWorte(ue->rechts.get());
+    } else if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        for (auto& arg : ce->argumente) sammleWorte(arg.get());
+    } else if (auto al = dynamic_cast<ArrayLiteralExpression*>(expr)) {
+        for (auto& e : al->elemente) sammleWorte(e.get());
+    } else if (auto kl = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        for (auto& e : kl->schluessel) sammleWorte(e.get());
+        for (auto& e : kl->werte) sammleWorte(e.get());
+    } else if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) {
+        sammleWorte(aa->array.get());
+        sammleWorte(aa->index.get());
+    } else if (auto fe = dynamic_cast<FeldzugriffExpression*>(expr)) {
+        sammleWorte(fe->objekt.get());
+    } else if (auto le = dynamic_cast<LeseExpression*>(expr)) {
+        sammleWorte(le->quelle.get());
+    } else if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) {
+        sammleWorte(tce->expression.get());
+    } else if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        for (auto& arg : ie->argumente) sammleWorte(arg.get());
+    } else if (auto ae = dynamic_cast<AufgabeExpression*>(expr)) {
+        sammleWorte(ae->aufruf.get());
+    } else if (auto we = dynamic_cast<WarteExpression*>(expr)) {
+        sammleWorte(we->aufgabe.get());
+    }
+}
+
+void Generator::sammleDruckteile(Expression* expr) {        // Literale Teile einer gedruckten Verkettung bleiben Literale: `<< "..."` braucht keinen String.
+    auto be = dynamic_cast<BinaryExpression*>(expr);
+    if (be != nullptr && be->op == "+") {
+        sammleDruckteile(be->links.get());
+        sammleDruckteile(be->rechts.get());
+        return;
+    }
+    sammleWorte(expr);
+}
+
+void Generator::merkeWort(Expression* expr) {
+    if (!istWortLiteral(expr)) return;
+    m_worte.emplace(std::any_cast<std::string>(static_cast<LiteralExpression*>(expr)->wert), m_worte.size());
+}
+
+void Generator::worteKonstanten(Ausgabe& ziel) {        // Gibt jedes gesammelte WORT-Literal einmal als std::string_view-Konstante aus. Sie ist schon beim Übersetzen initialisiert, also auch für globale Variablen anderer Module rechtzeitig da.
+    if (m_worte.empty()) return;
+    std::vector<const std::string*> nachNummer(m_worte.size());
+    for (auto& [text, nummer] : m_worte) nachNummer[nummer] = &text;
+    for (std::size_t i = 0; i < nachNummer.size(); ++i) {
+        ziel << "static constexpr std::string_view gerlang_wort_" << i << "(" << cppText(*nachNummer[i]) << ", " << nachNummer[i]->size() << ");\n";
+    }
+    ziel << "\n";
 }
 
 void Generator::visitFunctionDeclaration(FunctionDeclaration* fd) {     // Generiert den C++-Code für eine Funktionsdefinition (inkl. Parameter).
     if (fd->name == "haupt") {
         m_output << mapType(fd->returnTyp) << " main() \n";
     } else {
-        m_output << mapType(fd->returnTyp) << " " << fd->name << "(";
+        if (fd->merke) {
+            generiereMerkeHuelle(fd);
+            markiereZeile(fd);
+        }
+        if (fd->merke || !m_optionen.exportiert.count(fd->name)) {
+            m_output << "static ";
+        }
+        if (m_optionen.konstant && m_analyse.constexprFunktionen.count(fd->name)) {
+            m_output << "constexpr ";
+        }
+        m_output << mapType(fd->returnTyp) << " " << (fd->merke ? "gerlang_berechne_" : "") << fd->name << "(";
         for (size_t i = 0; i < fd->parameter.size(); ++i) {
             auto& param = fd->parameter[i];
             m_output << mapType(param.first) << " " << param.second;
@@ -123,10 +544,60 @@ void Generator::visitFunctionDeclaration(FunctionDeclaration* fd) {     // Gener
         }
         m_output << ") \n";
     }
-    visit(fd->body.get());
+
+    betreteScope();
+    for (auto& param : fd->parameter) {
+        deklariereVariable(param.second, param.first);
+    }
+    if (m_optionen.profil) {
+        m_profilOrte.push_back({fd->name, fd->zeile});
+        m_output << "{\n    GerlangProfilMessung gerlang_messung(" << m_profilBasis + m_profilOrte.size() - 1 << ");\n";
+        visit(fd->body.get());
+        m_output << "}\n";
+    } else {
+        visit(fd->body.get());
+    }
+    verlasseScope();
+}
+
+void Generator::generiereMerkeHuelle(FunctionDeclaration* fd) {      // MERKE: Die Funktion selbst heißt gerlang_berechne_<name>; unter dem Originalnamen steht eine Hülle, die Ergebnisse pro Argument-Tupel zwischenspeichert. Rekursive Aufrufe gehen so auch durch den Cache.
+    std::string rueckgabe = mapType(fd->returnTyp);
+    std::string parameter;
+    std::string tupelTypen;
+    std::string argumente;
+    bool mitWort = false;
+    for (size_t i = 0; i < fd->parameter.size(); ++i) {
+        auto& param = fd->parameter[i];
+        std::string trenner = (i + 1 < fd->parameter.size()) ? ", " : "";
+        parameter += mapType(param.first) + " " + param.second + trenner;
+        tupelTypen += mapType(param.first) + trenner;
+        argumente += param.second + trenner;
+        mitWort = mitWort || param.first == "WORT";
+    }
+    std::string grenze = fd->merkeGrenze > 0 ? std::to_string(fd->merkeGrenze) : "GERLANG_MERKE_GRENZE";
+
+    m_output << "static " << rueckgabe << " gerlang_berechne_" << fd->name << "(" << parameter << ");\n";
+    m_output << (m_optionen.exportiert.count(fd->name) ? "" : "static ") << rueckgabe << " " << fd->name << "(" << parameter << ") {\n";
+    // thread_local: AUFGABE und PARALLEL FUER dürfen die Funktion ohne Sperren aufrufen.
+    m_output << "    static thread_local " << (mitWort ? "GerlangMerkHash" : "GerlangMerkTabelle")
+             << "<std::tuple<" << tupelTypen << ">, " << rueckgabe << "> gerlang_cache(" << grenze << ");\n";
+    m_output << "    std::tuple<" << tupelTypen << "> gerlang_schluessel{" << argumente << "};\n";
+    m_output << "    if (const " << rueckgabe << "* gerlang_treffer = gerlang_cache.finde(gerlang_schluessel)) return *gerlang_treffer;\n";
+    m_output << "    " << rueckgabe << " gerlang_wert = gerlang_berechne_" << fd->name << "(" << argumente << ");\n";
+    m_output << "    gerlang_cache.speichere(std::move(gerlang_schluessel), gerlang_wert);\n";
+    m_output << "    return gerlang_wert;\n";
+    m_output << "}\n\n";
+}
+
+void Generator::visitImportDeclaration(ImportDeclaration* id) {     // HOLE ... VON: Bindet den generierten Header des Moduls ein.
+    m_output << "#include \"" << id->header << "\"\n";
 }
 
-void Generator::visitCallExpression(CallExpression* ce) {       // Generiert C++-Code für einen Funktionsaufruf (z.B. `addiere(a, b)`).
+void Generator::visitCallExpression(CallExpression* ce) {       // Generiert C++-Code für einen Funktionsaufruf (z.B. `addiere(a, b)`). Konstante Aufrufe reiner Funktionen wertet g++ über GERLANG_KONSTANT beim Kompilieren aus.
+    bool konstant = m_optionen.konstant && m_analyse.konstanteAufrufe.count(ce);
+    if (konstant) {
+        m_output << "GERLANG_KONSTANT(" << mapType(ermittleTyp(ce)) << ", ";
+    }
     visit(ce->aufrufer.get());
     
     m_output << "(";
@@ -139,22 +610,43 @@ void Generator::visitCallExpression(CallExpression* ce) {       // Generiert C++
     }
     
     m_output << ")";
+    if (konstant) {
+        m_output << ")";
+    }
 }
 
 void Generator::visitBlockStatement(BlockStatement* bs) {   // Generiert die geschweiften Klammern `{ ... }` und ruft `visit` für alle Statements im Block auf.
     m_output << "{\n";
+    betreteScope();
     for (auto& stmt : bs->statements) {
         if (stmt != nullptr) {
             visit(stmt.get());
         }
     }
+    verlasseScope();
     m_output << "}\n";
 }
 
-void Generator::visitPrintStatement(PrintStatement* ps) {   // Generiert C++-Code für `std::cout << ... << std::endl;`.
-    m_output << "    std::cout << ";
-    visit(ps->expression.get());
-    m_output << " << std::endl;\n";
+void Generator::visitPrintStatement(PrintStatement* ps) {   // Generiert C++-Code für `std::cout << ... << GERLANG_ZEILENENDE;` bzw. bei DATEI_SCHREIBE `gerlang_datei(pfad) << ... << '\n';`. WORT-Verkettungen werden zu einzelnen `<<`-Operanden, damit keine temporären Strings entstehen.
+    std::vector<Expression*> teile;
+    sammleVerkettung(ps->expression.get(), teile);
+
+    if (ps->datei) {
+        m_output << "    gerlang_datei(";
+        visit(ps->datei.get());
+        m_output << ")";
+    } else {
+        m_output << "    std::cout";
+    }
+    for (Expression* teil : teile) {
+        m_output << " << ";
+        visit(teil);
+    }
+    m_output << (ps->datei ? " << '\\n';\n" : " << GERLANG_ZEILENENDE;\n");
+}
+
+void Generator::visitFlushStatement(FlushStatement* fs) {       // Generiert C++-Code für `std::cout.flush();`.
+    m_output << "    std::cout.flush();\n";
 }
 
 void Generator::visitReturnStatement(ReturnStatement* rs) {     // Generiert C++-Code für `return ...;`.
@@ -167,7 +659,7 @@ void Generator::visitLiteralExpression(LiteralExpression* le) {     // Generiert
     if (le->typName == "GANZ") {
         m_output << std::any_cast<int>(le->wert);
     } else if (le->typName == "WORT") {
-        m_output << "\"" << std::any_cast<std::string>(le->wert) << "\"";
+        m_output << cppText(std::any_cast<std::string>(le->wert));
     } else if (le->typName == "JAIN") {
         m_output << (std::any_cast<bool>(le->wert) ? "true" : "false");
     } else if (le->typName == "KOMMA") {
@@ -175,6 +667,17 @@ void Generator::visitLiteralExpression(LiteralExpression* le) {     // Generiert
     }
 }
 
+void Generator::visitWortOperand(Expression* expr) {        // Operand eines Vergleichs oder einer Verkettung: Ein WORT-Literal wird zu seiner Konstante gerlang_wort_N, ohne String und ohne strlen.
+    if (istWortLiteral(expr)) {
+        auto gefunden = m_worte.find(std::any_cast<std::string>(static_cast<LiteralExpression*>(expr)->wert));
+        if (gefunden != m_worte.end()) {
+            m_output << "gerlang_wort_" << gefunden->second;
+            return;
+        }
+    }
+    visit(expr);
+}
+
 void Generator::visitIfStatement(IfStatement* is) {     // Generiert C++-Code für `if (...) { ... } else if (...) { ... } else { ... }`.
     m_output << "if (";
     visit(is->condition.get());
@@ -184,15 +687,37 @@ void Generator::visitIfStatement(IfStatement* is) {     // Generiert C++-Code f
     
     if (is->elseBranch != nullptr) {
         m_output << " else ";
+        if (!m_optionen.quellDatei.empty() && dynamic_cast<IfStatement*>(is->elseBranch.get())) {
+            m_output << "\n";      // #line muss am Zeilenanfang stehen.
+        }
         visit(is->elseBranch.get());
     }
     m_output << "\n";
 }
 
-void Generator::visitVariableDeclaration(VariableDeclaration* vd) {     // Generiert C++-Code für eine Variablendefinition (z.B. `int zahl = 10;`).
-    m_output << "    " << mapType(vd->typName) << " " << vd->name << " = ";
+void Generator::visitVariableDeclaration(VariableDeclaration* vd) {     // Generiert C++-Code für eine Variablendefinition (z.B. `int zahl = 10;`). Arrays fester Länge werden zu `std::array` auf dem Stack.
+    if (m_analyse.festeArrays.count(vd)) {
+        auto al = static_cast<ArrayLiteralExpression*>(vd->initializer.get());
+        m_output << "    std::array<" << mapType(elementTyp(vd->typName)) << ", " << al->elemente.size() << "> " << vd->name << " = ";
+    } else if (vd->typName == "AUFGABE") {
+        std::string aufgabenTyp = ermittleTyp(vd->initializer.get());
+        m_output << "    " << mapType(aufgabenTyp) << " " << vd->name << " = ";
+        visit(vd->initializer.get());
+        m_output << ";\n";
+        deklariereVariable(vd->name, aufgabenTyp);
+        return;
+    } else if (vd->typName == "WORT" && ermittleTyp(vd->initializer.get()) == "SICHT") {
+        m_output << "    std::string " << vd->name << "(";     // Der Konstruktor aus std::string_view ist explicit.
+        visit(vd->initializer.get());
+        m_output << ");\n";
+        deklariereVariable(vd->name, vd->typName);
+        return;
+    } else {
+        m_output << "    " << mapType(vd->typName) << " " << vd->name << " = ";
+    }
     visit(vd->initializer.get());
     m_output << ";\n";
+    deklariereVariable(vd->name, vd->typName);
 }
 
 void Generator::visitIdentifierExpression(IdentifierExpression* ie) {       // Generiert den C++-Code für einen Variablennamen.
@@ -200,11 +725,21 @@ void Generator::visitIdentifierExpression(IdentifierExpression* ie) {       // G
 }
 
 void Generator::visitBinaryExpression(BinaryExpression* be) {       // Generiert C++-Code für eine binäre Operation (z.B. `(a + b)` oder `(x < 10)`).
+    std::vector<Expression*> teile;
+    sammleVerkettung(be, teile);
+    bool mitSicht = teile.size() == 2 && (ermittleTyp(teile[0]) == "SICHT" || ermittleTyp(teile[1]) == "SICHT" || istWortLiteral(teile[0]) || istWortLiteral(teile[1]));
+    if (teile.size() > 2 || mitSicht) {     // std::string_view (auch ein konstantes WORT-Literal) hat kein operator+.
+        visitVerkettung(teile);
+        return;
+    }
+
+    bool vergleich = istVergleich(be->op);
     m_output << "(";
-    visit(be->links.get());
+    if (vergleich) visitWortOperand(be->links.get()); else visit(be->links.get());
     m_output << " " << mapOperator(be->op) << " ";
-    visit(be->rechts.get());
+    if (vergleich) visitWortOperand(be->rechts.get()); else visit(be->rechts.get());
     m_output << ")";
+
 }
 
 void Generator::visitUnaryExpression(UnaryExpression* ue) {     // Generiert C++-Code für eine unäre Operation (z.B. `(-5)` oder `(!flag)`).
@@ -215,27 +750,64 @@ void Generator::visitUnaryExpression(UnaryExpression* ue) {     // Generiert C++
     m_output << ")";
 }
 
-void Generator::visitAssignmentStatement(AssignmentStatement* as) {     // Generiert C++-Code für eine einfache Zuweisung (z.B. `zahl = 15;`).
+void Generator::visitAssignmentStatement(AssignmentStatement* as) {     // Generiert C++-Code für eine einfache Zuweisung (z.B. `zahl = 15;`). `s = s + ...` wird zu einem Anhängen an Ort und Stelle.
+    std::vector<Expression*> teile;
+    sammleVerkettung(as->wert.get(), teile);
+    auto erstes = dynamic_cast<IdentifierExpression*>(teile[0]);
+    if (teile.size() > 1 && erstes != nullptr && erstes->name == as->name) {
+        if (teile.size() == 2) {
+            m_output << "    " << as->name << " += ";
+            visitWortOperand(teile[1]);
+            m_output << ";\n";
+        } else {
+            m_output << "    gerlang_anhaengen(" << as->name << ", {";
+            for (size_t i = 1; i < teile.size(); ++i) {
+                visitWortOperand(teile[i]);
+                if (i < teile.size() - 1) {
+                    m_output << ", ";
+                }
+            }
+            m_output << "});\n";
+        }
+        return;
+    }
+
     m_output << "    " << as->name << " = ";
     visit(as->wert.get());
     m_output << ";\n";
 }
 
 void Generator::visitWhileStatement(WhileStatement* ws) {       // Generiert C++-Code für eine `while (...) { ... }` Schleife.
+    bool messen = beginneSchleifenMessung("SOLANGE", ws->zeile);
+    if (messen) markiereZeile(ws);
     m_output << "    while (";
     visit(ws->condition.get());
     m_output << ") ";
     
     visit(ws->body.get());
+    if (messen) m_output << "    }\n";
 }
 
 void Generator::visitForStatement(ForStatement* fs) {       // Generiert C++-Code für eine `for (...; ...; ...) { ... }` Schleife.
+    std::size_t anfang = m_output.position();
+    bool messen = beginneSchleifenMessung(fs->parallel ? "PARALLEL FUER" : "FUER", fs->zeile);
+    if (fs->parallel) {
+        if (messen) markiereZeile(fs);
+        visitParallelForStatement(fs);
+        if (messen) m_output << "    }\n";
+        return;
+    }
+    reserviereFuerSchleife(fs);
+    bool vektor = beginneVektorSchleife(fs);
+    if (m_output.position() != anfang) markiereZeile(fs);     // Vorbereitende Zeilen verschieben sonst die Zeilennummer der Schleife.
     m_output << "    for (";
+    betreteScope();
     
     if (fs->initializer != nullptr) {
         if (auto vd = dynamic_cast<VariableDeclaration*>(fs->initializer.get())) {
             m_output << mapType(vd->typName) << " " << vd->name << " = ";
             visit(vd->initializer.get());
+            deklariereVariable(vd->name, vd->typName);
         } else if (auto as = dynamic_cast<AssignmentStatement*>(fs->initializer.get())) {
              m_output << as->name << " = ";
              visit(as->wert.get());
@@ -259,6 +831,90 @@ void Generator::visitForStatement(ForStatement* fs) {       // Generiert C++-Cod
     m_output << ") ";
     
     visit(fs->body.get());
+    verlasseScope();
+    if (vektor) {
+        m_vektorZeiger.clear();
+        m_output << "    }\n";
+    }
+    if (messen) m_output << "    }\n";
+}
+
+bool Generator::beginneVektorSchleife(ForStatement* fs) {       // Für eine Schleife mit unabhängigen Durchläufen (siehe Analyzer::pruefeVektor): ein Block mit je einem __restrict-Zeiger pro Array und `#pragma omp simd`. Der Körper greift dann über die Zeiger zu.
+    auto gefunden = m_analyse.vektorSchleifen.find(fs);
+    if (gefunden == m_analyse.vektorSchleifen.end()) return false;
+    const VektorSchleife& vektor = gefunden->second;
+
+    m_output << "    {\n";
+    for (auto& [name, element] : vektor.arrays) {
+        std::string zeiger = "gerlang_simd_" + name;
+        m_output << "    " << (vektor.geschrieben.count(name) ? "" : "const ") << mapType(element) << "* __restrict " << zeiger << " = " << name << ".data();\n";
+        m_vektorZeiger[name] = zeiger;
+    }
+    m_output << "#pragma omp simd";
+    if (!vektor.summen.empty()) {
+        m_output << " reduction(+:";
+        for (auto it = vektor.summen.begin(); it != vektor.summen.end(); ++it) {
+            m_output << (it != vektor.summen.begin() ? ", " : "") << *it;
+        }
+        m_output << ")";
+    }
+    m_output << "\n";
+    return true;
+}
+
+void Generator::arrayName(const std::string& name) {      // Name eines Arrays beim Zugriff mit []; in einer `omp simd`-Schleife der __restrict-Zeiger.
+    auto zeiger = m_vektorZeiger.find(name);
+    m_output << (zeiger != m_vektorZeiger.end() ? zeiger->second : name);
+}
+
+void Generator::visitFuerJedesStatement(FuerJedesStatement* js) {      // Generiert eine range-for-Schleife: Zahlen und JAIN als Kopie, WORT und STRUKTUR als const-Referenz auf das Element. Ein Array-Literal wird zur std::initializer_list.
+    bool messen = beginneSchleifenMessung("FUER JEDES", js->zeile);
+    if (messen) markiereZeile(js);
+    const std::string& typ = js->typName;
+    bool kopie = typ == "GANZ" || typ == "KOMMA" || typ == "JAIN" || typ == "SICHT";
+    m_output << "    for (" << (kopie ? "" : "const ") << mapType(typ) << (kopie ? " " : "& ") << js->name << " : ";
+    if (dynamic_cast<ArrayLiteralExpression*>(js->liste.get())) {
+        m_output << "std::initializer_list<" << mapType(typ) << ">";
+    }
+    visit(js->liste.get());
+    m_output << ") ";
+    betreteScope();
+    deklariereVariable(js->name, typ);
+    visit(js->body.get());
+    verlasseScope();
+    if (messen) m_output << "    }\n";
+}
+
+void Generator::visitParallelForStatement(ForStatement* fs) {       // Generiert C++-Code für PARALLEL FUER: Der Schleifenkörper wird zu einem Lambda über einen Teilbereich, den der Thread-Pool der Laufzeit verteilt. Bei SUMME(r) rechnet jeder Teil in einer eigenen Variable `r`.
+    Zaehlschleife schleife;
+    erkenneZaehlschleife(fs, schleife);
+
+    std::string reduktionsTyp = mapType(variablenTyp(fs->reduktion));
+    if (fs->reduktion.empty()) {
+        m_output << "    gerlang_parallel_fuer(";
+    } else {
+        m_output << "    " << fs->reduktion << " += gerlang_parallel_summe<" << reduktionsTyp << ">(";
+    }
+    visit(schleife.start);
+    m_output << ", ";
+    visit(schleife.ende);
+    if (schleife.inklusiv) {
+        m_output << " + 1";
+    }
+    m_output << ", [&](long long gerlang_von, long long gerlang_bis) {\n";
+
+    betreteScope();
+    deklariereVariable(schleife.variable, "GANZ");
+    if (!fs->reduktion.empty()) {
+        m_output << "    " << reduktionsTyp << " " << fs->reduktion << "{};\n";
+    }
+    m_output << "    for (int " << schleife.variable << " = static_cast<int>(gerlang_von); " << schleife.variable << " < gerlang_bis; ++" << schleife.variable << ") ";
+    visit(fs->body.get());
+    if (!fs->reduktion.empty()) {
+        m_output << "    return " << fs->reduktion << ";\n";
+    }
+    verlasseScope();
+    m_output << "    });\n";
 }
 
 void Generator::visitArrayLiteralExpression(ArrayLiteralExpression* al) {       // Generiert C++-Code für eine Initialisierungsliste (z.B. `{10, 20, 30}`).
@@ -272,25 +928,166 @@ void Generator::visitArrayLiteralExpression(ArrayLiteralExpression* al) {
     m_output << "}";
 }
 
-void Generator::visitArrayAccessExpression(ArrayAccessExpression* aa) {     // Generiert C++-Code für einen Array-Zugriff (z.B. `liste[0]`).
-    visit(aa->array.get());
+void Generator::visitKartenLiteralExpression(KartenLiteralExpression* kl) {     // Generiert eine Initialisierungsliste aus Paaren (z.B. `{{"a", 1}, {"b", 2}}`).
+    m_output << "{";
+    for (size_t i = 0; i < kl->schluessel.size(); ++i) {
+        m_output << "{";
+        visit(kl->schluessel[i].get());
+        m_output << ", ";
+        visit(kl->werte[i].get());
+        m_output << "}";
+        if (i < kl->schluessel.size() - 1) {
+            m_output << ", ";
+        }
+    }
+    m_output << "}";
+}
+
+void Generator::visitArrayAccessExpression(ArrayAccessExpression* aa) {     // Generiert C++-Code für einen Array-Zugriff (z.B. `liste[0]`). Lesen aus einer KARTE legt keinen Eintrag an: `m.lies(k)`.
+    auto name = dynamic_cast<IdentifierExpression*>(aa->array.get());
+    if (name != nullptr) arrayName(name->name); else visit(aa->array.get());
+    if (istKarte(ermittleTyp(aa->array.get()))) {
+        m_output << ".lies(";
+        visit(aa->index.get());
+        m_output << ")";
+        return;
+    }
     m_output << "[";
     visit(aa->index.get());
     m_output << "]";
 }
 
-void Generator::visitArrayAssignmentStatement(ArrayAssignmentStatement* aas) {      // Generiert C++-Code für eine Zuweisung an ein Array-Element (z.B. `liste[0] = 99;`).
-    m_output << "    " << aas->name << "[";
+void Generator::visitArrayAssignmentStatement(ArrayAssignmentStatement* aas) {      // Generiert C++-Code für eine Zuweisung an ein Array-Element (z.B. `liste[0] = 99;`). In Spalten-Arrays schreibt `setze` jedes Feld in seine Spalte. `m[k] = m[k] + x` auf einer KARTE wird zu `m[k] += x` und sucht den Schlüssel nur einmal.
+    std::string zielTyp = variablenTyp(aas->name);
+    auto be = dynamic_cast<BinaryExpression*>(aas->wert.get());
+    if (istKarte(zielTyp) && be != nullptr && (be->op == "+" || be->op == "-" || be->op == "*")) {
+        auto alt = dynamic_cast<ArrayAccessExpression*>(be->links.get());
+        auto altName = alt != nullptr ? dynamic_cast<IdentifierExpression*>(alt->array.get()) : nullptr;
+        if (altName != nullptr && altName->name == aas->name && gleicherSchluessel(alt->index.get(), aas->index.get())) {
+            m_output << "    " << aas->name << "[";
+            visit(aas->index.get());
+            m_output << "] " << be->op << "= ";
+            visit(be->rechts.get());
+            m_output << ";\n";
+            return;
+        }
+    }
+    if (istSpaltenArray(zielTyp)) {
+        m_output << "    " << aas->name << ".setze(";
+        visit(aas->index.get());
+        m_output << ", ";
+        visit(aas->wert.get());
+        m_output << ");\n";
+        return;
+    }
+    m_output << "    ";
+    arrayName(aas->name);
+    m_output << "[";
     visit(aas->index.get());
     m_output << "] = ";
     visit(aas->wert.get());
     m_output << ";\n";
 }
 
-void Generator::visitLeseExpression(LeseExpression* le) {       // Generiert einen Aufruf der `gerlang_lese()` Helper-Funktion.
+void Generator::visitFeldZuweisungStatement(FeldZuweisungStatement* fz) {      // Generiert `p.x = ...;`, `punkte[i].x = ...;` bzw. bei Spalten-Arrays `punkte.x[i] = ...;`.
+    m_output << "    " << fz->name;
+    if (fz->index != nullptr && istSpaltenArray(variablenTyp(fz->name))) {
+        m_output << "." << fz->feld << "[";
+        visit(fz->index.get());
+        m_output << "]";
+    } else {
+        if (fz->index != nullptr) {
+            m_output << "[";
+            visit(fz->index.get());
+            m_output << "]";
+        }
+        m_output << "." << fz->feld;
+    }
+    m_output << " = ";
+    visit(fz->wert.get());
+    m_output << ";\n";
+}
+
+void Generator::visitFeldzugriffExpression(FeldzugriffExpression* fe) {     // Generiert `p.x` bzw. `punkte.x[i]` für ein Element eines Spalten-Arrays, damit nur die eine Spalte gelesen wird.
+    auto aa = dynamic_cast<ArrayAccessExpression*>(fe->objekt.get());
+    if (aa != nullptr && istSpaltenArray(ermittleTyp(aa->array.get()))) {
+        visit(aa->array.get());
+        m_output << "." << fe->feld << "[";
+        visit(aa->index.get());
+        m_output << "]";
+        return;
+    }
+    visit(fe->objekt.get());
+    m_output << "." << fe->feld;
+}
+
+void Generator::visitStrukturDeclaration(StrukturDeclaration* sd) {     // Generiert den Typ der STRUKTUR (siehe strukturCode).
+    m_output << strukturCode(sd);
+}
+
+std::string Generator::strukturCode(const StrukturDeclaration* sd) {        // Ein struct mit Konstruktor und operator<< für DRUCKE. Ohne KOMPAKT zusätzlich gerlang_spalten_<Name>: ein std::vector pro Feld, mit der Schnittstelle, die Arrays sonst haben (size, push_back, reserve, [] als Wert, setze, begin/end für FUER JEDES).
+    std::string name = sd->name;
+    std::string code = "struct " + name + " {\n";
+    std::string parameter;
+    std::string initialisierer;
+    std::string drucke;
+    for (size_t i = 0; i < sd->felder.size(); ++i) {
+        auto& [typ, feld] = sd->felder[i];
+        std::string trenner = (i + 1 < sd->felder.size()) ? ", " : "";
+        code += "    " + mapType(typ) + " " + feld + "{};\n";
+        parameter += mapType(typ) + " " + feld + trenner;
+        initialisierer += feld + "(std::move(" + feld + "))" + trenner;
+        drucke += std::string(" << ") + (i > 0 ? "\", \" << " : "") + "w." + feld;
+    }
+    code += "    " + name + "() = default;\n";
+    code += "    " + name + "(" + parameter + ") : " + initialisierer + " {}\n";
+    code += "};\n";
+    code += "inline std::ostream& operator<<(std::ostream& aus, const " + name + "& w) { return aus << \"" + name + "(\"" + drucke + " << ')'; }\n";
+    if (sd->kompakt) return code;
+
+    // Innerhalb von gerlang_spalten_<Name> sind die Feldnamen Member; alle eigenen Namen tragen daher das Präfix gerlang_.
+    std::string spalten = "gerlang_spalten_" + name;
+    std::string erstes = sd->felder[0].second;
+    std::string reserviere, anhaengen, lesen, setzen;
+    code += "struct " + spalten + " {\n";
+    for (size_t i = 0; i < sd->felder.size(); ++i) {
+        auto& [typ, feld] = sd->felder[i];
+        code += "    std::vector<" + mapType(typ) + "> " + feld + ";\n";
+        reserviere += " " + feld + ".reserve(gerlang_n);";
+        anhaengen += " " + feld + ".push_back(gerlang_wert." + feld + ");";
+        lesen += (i > 0 ? ", " : "") + feld + "[gerlang_i]";
+        setzen += " " + feld + "[gerlang_i] = gerlang_wert." + feld + ";";
+    }
+    code += "    " + spalten + "() = default;\n";
+    code += "    " + spalten + "(std::initializer_list<" + name + "> gerlang_werte) { reserve(gerlang_werte.size()); for (const " + name +
+            "& gerlang_wert : gerlang_werte) push_back(gerlang_wert); }\n";
+    code += "    std::size_t size() const { return " + erstes + ".size(); }\n";
+    code += "    std::size_t capacity() const { return " + erstes + ".capacity(); }\n";
+    code += "    void reserve(std::size_t gerlang_n) {" + reserviere + " }\n";
+    code += "    void push_back(const " + name + "& gerlang_wert) {" + anhaengen + " }\n";
+    code += "    " + name + " operator[](std::size_t gerlang_i) const { return " + name + "(" + lesen + "); }\n";
+    code += "    void setze(std::size_t gerlang_i, const " + name + "& gerlang_wert) {" + setzen + " }\n";
+    code += "    struct iterator { const " + spalten + "* gerlang_spalten; std::size_t gerlang_i; " + name + " operator*() const { return (*gerlang_spalten)[gerlang_i]; } "
+            "iterator& operator++() { ++gerlang_i; return *this; } bool operator!=(const iterator& gerlang_anderes) const { return gerlang_i != gerlang_anderes.gerlang_i; } };\n";
+    code += "    iterator begin() const { return {this, 0}; }\n";
+    code += "    iterator end() const { return {this, size()}; }\n";
+    code += "};\n";
+    return code;
+}
+
+void Generator::visitLeseExpression(LeseExpression* le) {       // Generiert einen Aufruf der `gerlang_lese()` Helper-Funktion, bei LESE(z) `z.naechste()`.
+    if (le->quelle) {
+        visit(le->quelle.get());
+        m_output << ".naechste()";
+        return;
+    }
     m_output << "gerlang_lese()";
 }
 
+void Generator::visitLeseAlleExpression(LeseAlleExpression* lae) {      // Generiert einen Aufruf der `gerlang_lese_alle()` Helper-Funktion.
+    m_output << "gerlang_lese_alle()";
+}
+
 void Generator::visitTypeConversionExpression(TypeConversionExpression* tce) {      // Generiert einen Aufruf der passenden `gerlang_zu_...()` Helper-Funktion.
     if (tce->zielTyp == "GANZ") {
         m_output << "gerlang_zu_ganz(";
@@ -302,4 +1099,226 @@ void Generator::visitTypeConversionExpression(TypeConversionExpression* tce) {
     
     visit(tce->expression.get());
     m_output << ")";
-}
\ No newline at end of file
+}
+
+void Generator::visitIntrinsicStatement(IntrinsicStatement* is) {      // Generiert C++-Code für eine eingebaute Array-Funktion als Anweisung (z.B. `liste.push_back(5);`).
+    m_output << "    ";
+    visitIntrinsicExpression(is->aufruf.get());
+    m_output << ";\n";
+}
+
+void Generator::visitIntrinsicExpression(IntrinsicExpression* ie) {     // Generiert C++-Code für LAENGE, SUMME, HINZUFUEGEN, SORTIERE, DATEI_LESE und DATEI_ZEILEN über die Helper der Laufzeitbibliothek, ENTHAELT, SCHLUESSEL und DATEI_ENDE als Methoden.
+    if (ie->name == "HINZUFUEGEN") {
+        visit(ie->argumente[0].get());
+        m_output << ".push_back(";
+        visit(ie->argumente[1].get());
+        m_output << ")";
+        return;
+    }
+
+    if (ie->name == "ENTHAELT") {
+        visit(ie->argumente[0].get());
+        m_output << ".enthaelt(";
+        visit(ie->argumente[1].get());
+        m_output << ")";
+        return;
+    }
+    if (ie->name == "SCHLUESSEL") {
+        visit(ie->argumente[0].get());
+        m_output << ".schluessel()";
+        return;
+    }
+    if (ie->name == "DATEI_ENDE") {
+        visit(ie->argumente[0].get());
+        m_output << ".ende()";
+        return;
+    }
+
+    if (ie->name == "LAENGE") {
+        m_output << "gerlang_laenge(";
+    } else if (ie->name == "SUMME") {
+        m_output << "gerlang_summe(";
+    } else if (ie->name == "SORTIERE") {
+        m_output << "gerlang_sortiere(";
+    } else if (ie->name == "DATEI_LESE") {
+        m_output << "gerlang_datei_lese(";
+    } else if (ie->name == "DATEI_ZEILEN") {
+        m_output << "gerlang_datei_zeilen(";
+    }
+    visit(ie->argumente[0].get());
+    m_output << ")";
+}
+
+void Generator::visitAufgabeExpression(AufgabeExpression* ae) {     // Generiert `gerlang_starte(f, args...)`. Die Argumente werden sofort ausgewertet und per Wert an den Task übergeben.
+    m_output << "gerlang_starte(";
+    visit(ae->aufruf->aufrufer.get());
+    for (auto& arg : ae->aufruf->argumente) {
+        m_output << ", ";
+        visit(arg.get());
+    }
+    m_output << ")";
+}
+
+void Generator::visitWarteExpression(WarteExpression* we) {     // Generiert `gerlang_warte(h)`.
+    m_output << "gerlang_warte(";
+    visit(we->aufgabe.get());
+    m_output << ")";
+}
+
+void Generator::reserviereFuerSchleife(ForStatement* fs) {      // Reserviert vor einer gezählten FUER-Schleife Platz für alle HINZUFUEGEN im Schleifenkörper, damit push_back nicht wiederholt neu allokiert.
+    Zaehlschleife schleife;
+    auto body = dynamic_cast<BlockStatement*>(fs->body.get());
+    if (body == nullptr || !erkenneZaehlschleife(fs, schleife) ||
+        !istSeiteneffektfrei(schleife.start) || !istSeiteneffektfrei(schleife.ende)) {
+        return;
+    }
+
+    std::map<std::string, int> anhaenge;
+    for (auto& stmt : body->statements) {
+        auto is = dynamic_cast<IntrinsicStatement*>(stmt.get());
+        if (is == nullptr || is->aufruf->name != "HINZUFUEGEN") continue;
+        auto ziel = dynamic_cast<IdentifierExpression*>(is->aufruf->argumente[0].get());
+        if (ziel != nullptr && elementTyp(ermittleTyp(ziel)) != "") {
+            anhaenge[ziel->name]++;
+        }
+    }
+
+    for (auto& [name, anzahl] : anhaenge) {
+        m_output << "    gerlang_reserviere(" << name << ", ((";
+        visit(schleife.ende);
+        m_output << ") - (";
+        visit(schleife.start);
+        m_output << ")" << (schleife.inklusiv ? " + 1" : "") << ")";
+        if (anzahl > 1) {
+            m_output << " * " << anzahl;
+        }
+        m_output << ");\n";
+    }
+}
+
+void Generator::betreteScope() {        // Öffnet einen neuen Gültigkeitsbereich für Variablentypen.
+    m_scopes.emplace_back();
+}
+
+void Generator::verlasseScope() {       // Schließt den innersten Gültigkeitsbereich wieder.
+    m_scopes.pop_back();
+}
+
+void Generator::deklariereVariable(const std::string& name, const std::string& typ) {      // Merkt sich den GerLang-Typ einer Variable im aktuellen Gültigkeitsbereich.
+    if (!m_scopes.empty()) {
+        m_scopes.back()[name] = typ;
+    }
+}
+
+std::string Generator::variablenTyp(const std::string& name) {     // Sucht den GerLang-Typ einer Variable vom innersten Gültigkeitsbereich nach außen. Gibt "" zurück, wenn sie unbekannt ist.
+    for (auto it = m_scopes.rbegin(); it != m_scopes.rend(); ++it) {
+        auto gefunden = it->find(name);
+        if (gefunden != it->end()) {
+            return gefunden->second;
+        }
+    }
+    return "";
+}
+
+std::string Generator::ermittleTyp(Expression* expr) {      // Bestimmt den GerLang-Typ eines Ausdrucks (z.B. "WORT"), soweit er ohne vollständige Typprüfung bekannt ist. Gibt "" zurück, wenn er unbekannt ist.
+    if (auto le = dynamic_cast<LiteralExpression*>(expr)) {
+        return le->typName;
+    }
+    if (auto ie = dynamic_cast<IdentifierExpression*>(expr)) {
+        return variablenTyp(ie->name);
+    }
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        const std::string& op = be->op;
+        if (op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=" || op == "UND" || op == "ODER") {
+            return "JAIN";
+        }
+        std::string links = ermittleTyp(be->links.get());
+        std::string rechts = ermittleTyp(be->rechts.get());
+        if (op == "+" && (links == "WORT" || rechts == "WORT" || links == "SICHT" || rechts == "SICHT")) return "WORT";
+        if (links == "KOMMA" || rechts == "KOMMA") return "KOMMA";
+        return links;
+    }
+    if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        if (ue->op == "NICHT" || ue->op == "!") return "JAIN";
+        return ermittleTyp(ue->rechts.get());
+    }
+    if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        if (auto name = dynamic_cast<IdentifierExpression*>(ce->aufrufer.get())) {
+            auto gefunden = m_funktionsTypen.find(name->name);
+            if (gefunden != m_funktionsTypen.end()) {
+                return gefunden->second;
+            }
+        }
+        return "";
+    }
+    if (auto al = dynamic_cast<ArrayLiteralExpression*>(expr)) {
+        if (al->elemente.empty()) return "";
+        return ermittleTyp(al->elemente[0].get()) + "[]";
+    }
+    if (auto kl = dynamic_cast<KartenLiteralExpression*>(expr)) {
+        if (kl->schluessel.empty()) return "";
+        return "KARTE<" + ermittleTyp(kl->schluessel[0].get()) + "," + ermittleTyp(kl->werte[0].get()) + ">";
+    }
+    if (auto aa = dynamic_cast<ArrayAccessExpression*>(expr)) {
+        std::string behaelter = ermittleTyp(aa->array.get());
+        std::string schluessel, wert;
+        if (zerlegeKarte(behaelter, schluessel, wert)) return wert;
+        return elementTyp(behaelter);
+    }
+    if (auto le = dynamic_cast<LeseExpression*>(expr)) {
+        return le->quelle ? "SICHT" : "WORT";
+    }
+    if (dynamic_cast<LeseAlleExpression*>(expr)) {
+        return "WORT[]";
+    }
+    if (auto tce = dynamic_cast<TypeConversionExpression*>(expr)) {
+        return tce->zielTyp;
+    }
+    if (auto fe = dynamic_cast<FeldzugriffExpression*>(expr)) {
+        return feldTyp(ermittleTyp(fe->objekt.get()), fe->feld);
+    }
+    if (auto ie = dynamic_cast<IntrinsicExpression*>(expr)) {
+        if (ie->name == "LAENGE") return "GANZ";
+        if (ie->name == "ENTHAELT" || ie->name == "DATEI_ENDE") return "JAIN";
+        if (ie->name == "DATEI_LESE") return "SICHT";
+        if (ie->name == "DATEI_ZEILEN") return "ZEILEN";
+        if (ie->name == "SCHLUESSEL") {
+            std::string schluessel, wert;
+            return zerlegeKarte(ermittleTyp(ie->argumente[0].get()), schluessel, wert) ? schluessel + "[]" : "";
+        }
+        if (ie->name == "SUMME") return elementTyp(ermittleTyp(ie->argumente[0].get()));
+        return "";
+    }
+    if (auto ae = dynamic_cast<AufgabeExpression*>(expr)) {
+        return "AUFGABE<" + ermittleTyp(ae->aufruf.get()) + ">";
+    }
+    if (auto we = dynamic_cast<WarteExpression*>(expr)) {
+        std::string aufgabenTyp = ermittleTyp(we->aufgabe.get());
+        if (aufgabenTyp.rfind("AUFGABE<", 0) == 0) {
+            return aufgabenTyp.substr(8, aufgabenTyp.size() - 9);
+        }
+        return "";
+    }
+    return "";
+}
+
+void Generator::sammleVerkettung(Expression* expr, std::vector<Expression*>& teile) {       // Zerlegt eine WORT-Verkettung `a + b + c` in ihre einzelnen Operanden. Alles andere bleibt ein einzelner Teil.
+    auto be = dynamic_cast<BinaryExpression*>(expr);
+    if (be != nullptr && be->op == "+" && ermittleTyp(be) == "WORT") {
+        sammleVerkettung(be->links.get(), teile);
+        sammleVerkettung(be->rechts.get(), teile);
+        return;
+    }
+    teile.push_back(expr);
+}
+
+void Generator::visitVerkettung(const std::vector<Expression*>& teile) {        // Generiert einen Aufruf von `gerlang_verbinde({...})`, der den Ergebnis-String einmal vorab reserviert.
+    m_output << "gerlang_verbinde({";
+    for (size_t i = 0; i < teile.size(); ++i) {
+        visitWortOperand(teile[i]);
+        if (i < teile.size() - 1) {
+            m_output << ", ";
+        }
+    }
+    m_output << "})";
+}
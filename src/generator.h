@@ -1,41 +1,119 @@
 #pragma once
 #include <string>
 #include <sstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
 #include "ast.h"
+#include "analyzer.h"
+#include "ausgabe.h"
+
+// Einstellungen des Generators, die der Treiber aus den Kommandozeilenoptionen setzt.
+struct GeneratorOptionen {
+    bool profil = false;            // --profile: Messpunkte in jeder Funktion (runtime/gerlang_profil.h).
+    bool profilSchleifen = false;   // --profile-schleifen: zusätzlich in jeder Schleife.
+    std::string quellDatei;         // Pfad der .gc-Datei für #line-Direktiven; leer = keine.
+    unsigned threads = 0;           // --jobs=N: Threads für die Codeerzeugung; 0 = alle Kerne.
+    bool konstant = true;           // constexpr-Funktionen und gefaltete Aufrufe aus der Analyse übernehmen.
+    std::set<std::string> exportiert;   // Funktionen, die andere Module mit HOLE importieren. Alle anderen außer haupt sind static.
+};
 
 class Generator {
 public:
-    Generator(std::unique_ptr<Program> program);
+    Generator(std::unique_ptr<Program> program, AnalyseErgebnis analyse = {}, GeneratorOptionen optionen = {});
     
+    void generate(Ausgabe& ziel);
     std::string generate();
+    std::string schnittstelle();
 
 private:
+    // Eine Top-Level-Deklaration mit dem Zustand, den sie beim Generieren vorfindet.
+    struct Abschnitt {
+        Statement* stmt;
+        std::shared_ptr<const std::map<std::string, std::string>> globale;    // Bis hierhin deklarierte globale Variablen.
+        std::size_t profilBasis;                                                // Nummer der ersten Messstelle.
+    };
+
+    Generator(const Generator& haupt);      // Arbeiter für generiereParallel: gleiche Analyse, Optionen und Funktionstypen, eigene Ausgabe.
+
     std::unique_ptr<Program> m_program;
-    std::stringstream m_output;
+    AnalyseErgebnis m_analyse;
+    GeneratorOptionen m_optionen;
+    std::vector<std::pair<std::string, int>> m_profilTabelle;     // Alle Messstellen für --profile (Name, .gc-Zeile); der Index ist die Nummer im Code.
+    std::vector<std::pair<std::string, int>> m_profilOrte;        // Messstellen des aktuellen Abschnitts, ab Nummer m_profilBasis.
+    std::size_t m_profilBasis = 0;
+    SpeicherAusgabe m_output;                                     // Code der aktuellen Top-Level-Deklaration.
+    std::vector<std::map<std::string, std::string>> m_scopes;     // Variablentypen je Block (innerster Block zuletzt).
+    std::map<std::string, std::string> m_funktionsTypen;          // Rückgabetypen aller Top-Level-Funktionen.
+    std::map<std::string, const StrukturDeclaration*> m_strukturen;     // Alle STRUKTUR-Deklarationen nach Name.
+    std::map<std::string, std::size_t> m_worte;                   // WORT-Literale aus Vergleichen und Verkettungen -> Nummer ihrer Konstante gerlang_wort_N.
+    std::map<std::string, std::string> m_vektorZeiger;           // Arrays der aktuellen `omp simd`-Schleife -> ihr __restrict-Zeiger.
 
     void visit(Statement* stmt);
+    void markiereZeile(Statement* stmt);
     void visit(Expression* expr);
 
-    void visitProgram(Program* p);
+    void visitProgram(Program* p, Ausgabe& ziel);
+    void generiereAbschnitt(const Abschnitt& abschnitt);
+    void generiereParallel(const std::vector<Abschnitt>& abschnitte, unsigned threads, Ausgabe& ziel);
+    std::size_t zaehleProfilOrte(Statement* stmt);
+    void sammleWorte(Statement* stmt);
+    void sammleWorte(Expression* expr);
+    void sammleDruckteile(Expression* expr);
+    void merkeWort(Expression* expr);
+    void worteKonstanten(Ausgabe& ziel);
     void visitFunctionDeclaration(FunctionDeclaration* fd);
+    void generiereMerkeHuelle(FunctionDeclaration* fd);
     void visitBlockStatement(BlockStatement* bs);
     void visitPrintStatement(PrintStatement* ps);
+    void visitFlushStatement(FlushStatement* fs);
+    void visitImportDeclaration(ImportDeclaration* id);
+    void visitStrukturDeclaration(StrukturDeclaration* sd);
+    std::string strukturCode(const StrukturDeclaration* sd);
     void visitReturnStatement(ReturnStatement* rs);
     void visitIfStatement(IfStatement* is);
     void visitVariableDeclaration(VariableDeclaration* vd);
     void visitAssignmentStatement(AssignmentStatement* as);
     void visitWhileStatement(WhileStatement* ws);
     void visitForStatement(ForStatement* fs);
+    void visitParallelForStatement(ForStatement* fs);
+    void visitFuerJedesStatement(FuerJedesStatement* js);
     void visitArrayAssignmentStatement(ArrayAssignmentStatement* aas);
+    void visitFeldZuweisungStatement(FeldZuweisungStatement* fz);
+    void visitIntrinsicStatement(IntrinsicStatement* is);
     void visitLiteralExpression(LiteralExpression* le);
+    void visitWortOperand(Expression* expr);
     void visitIdentifierExpression(IdentifierExpression* ie);
     void visitBinaryExpression(BinaryExpression* be);
     void visitUnaryExpression(UnaryExpression* ue);
     void visitCallExpression(CallExpression* ce);
     void visitArrayLiteralExpression(ArrayLiteralExpression* al);
+    void visitKartenLiteralExpression(KartenLiteralExpression* kl);
     void visitArrayAccessExpression(ArrayAccessExpression* aa);
+    void visitFeldzugriffExpression(FeldzugriffExpression* fe);
     void visitLeseExpression(LeseExpression* le);
+    void visitLeseAlleExpression(LeseAlleExpression* lae);
     void visitTypeConversionExpression(TypeConversionExpression* tce);
+    void visitIntrinsicExpression(IntrinsicExpression* ie);
+    void visitAufgabeExpression(AufgabeExpression* ae);
+    void visitWarteExpression(WarteExpression* we);
+    void reserviereFuerSchleife(ForStatement* fs);
+    bool beginneVektorSchleife(ForStatement* fs);
+    void arrayName(const std::string& name);
+    bool beginneSchleifenMessung(const std::string& name, int zeile);
+    void profilTabelle(Ausgabe& ziel);
     
     std::string mapType(const std::string& gerlangType);
+    std::string elementTyp(const std::string& arrayTyp);
+    bool istSpaltenArray(const std::string& typ);
+    std::string feldTyp(const std::string& strukturTyp, const std::string& feld);
+
+    void betreteScope();
+    void verlasseScope();
+    void deklariereVariable(const std::string& name, const std::string& typ);
+    std::string variablenTyp(const std::string& name);
+    std::string ermittleTyp(Expression* expr);
+    void sammleVerkettung(Expression* expr, std::vector<Expression*>& teile);
+    void visitVerkettung(const std::vector<Expression*>& teile);
 };
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "gppc.h"
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include "analyzer.h"
+#include "ausgabe.h"
+#include "generator.h"
+#include "lexer.h"
+#include "parser.h"
+
+namespace gppc {
+
+namespace {
+
+Diagnose zerlege(Diagnose::Art art, const std::string& meldung) {       // Parser und Analyse beginnen ihre Meldungen mit "Zeile N: "; daraus wird das Feld `zeile`.
+    Diagnose diagnose{art, 0, meldung};
+    if (meldung.rfind("Zeile ", 0) != 0) return diagnose;
+    std::size_t doppelpunkt = meldung.find(": ", 6);
+    if (doppelpunkt == std::string::npos || doppelpunkt == 6) return diagnose;
+    if (meldung.find_first_not_of("0123456789", 6) != doppelpunkt) return diagnose;
+    diagnose.zeile = std::stoi(meldung.substr(6, doppelpunkt - 6));
+    diagnose.text = meldung.substr(doppelpunkt + 2);
+    return diagnose;
+}
+
+std::string constexprBericht(const AnalyseErgebnis& analyse, bool konstant) {       // Welche Funktionen constexpr werden (bzw. warum nicht) und welche Aufrufe mit konstanten Argumenten g++ beim Kompilieren ausrechnet.
+    std::ostringstream bericht;
+    if (!konstant) {
+        bericht << "(mit --profile ausgeschaltet, die Messpunkte sind nicht constexpr)\n";
+        return bericht.str();
+    }
+    for (auto& name : analyse.constexprFunktionen) {
+        bericht << "constexpr  " << name << "\n";
+    }
+    for (auto& [name, grund] : analyse.keinConstexpr) {
+        bericht << "nein       " << name << ": " << grund << "\n";
+    }
+
+    std::vector<std::pair<int, std::string>> aufrufe;
+    for (auto& [aufruf, grund] : analyse.laufzeitAufrufe) {
+        auto name = static_cast<const IdentifierExpression*>(aufruf->aufrufer.get());
+        aufrufe.push_back({aufruf->zeile, name->name + "(...) bleibt zur Laufzeit: " + grund});
+    }
+    std::sort(aufrufe.begin(), aufrufe.end());
+    for (auto& [zeile, text] : aufrufe) {
+        bericht << "Zeile " << zeile << ": " << text << "\n";
+    }
+    bericht << analyse.konstanteAufrufe.size() << " Aufruf(e) werden beim Kompilieren ausgewertet.\n";
+    return bericht.str();
+}
+
+std::string vektorBericht(const AnalyseErgebnis& analyse) {      // Jede FUER-Schleife nach Zeile: markiert (mit Arrays und Summen) oder warum nicht.
+    std::vector<std::pair<int, std::string>> schleifen;
+    for (auto& [schleife, vektor] : analyse.vektorSchleifen) {
+        std::string text = "omp simd (";
+        for (auto it = vektor.arrays.begin(); it != vektor.arrays.end(); ++it) {
+            text += (it != vektor.arrays.begin() ? ", " : "") + it->first + (vektor.geschrieben.count(it->first) ? " schreibend" : " lesend");
+        }
+        for (auto& summe : vektor.summen) {
+            text += ", Summe " + summe;
+        }
+        schleifen.push_back({schleife->zeile, text + ")"});
+    }
+    for (auto& [schleife, grund] : analyse.keineVektorSchleife) {
+        schleifen.push_back({schleife->zeile, "nein: " + grund});
+    }
+    std::sort(schleifen.begin(), schleifen.end());
+
+    std::ostringstream bericht;
+    for (auto& [zeile, text] : schleifen) {
+        bericht << "Zeile " << zeile << ": " << text << "\n";
+    }
+    bericht << analyse.vektorSchleifen.size() << " von " << schleifen.size() << " FUER-Schleife(n) mit #pragma omp simd.\n";
+    return bericht.str();
+}
+
+Ergebnis uebersetze(std::string_view quelltext, const Optionen& optionen, Ausgabe* ziel) {      // Gemeinsamer Weg beider compile-Varianten; ohne `ziel` landet der Code in Ergebnis::cpp.
+    Ergebnis ergebnis;
+    TokenListe tokens{std::string()};
+    try {
+        tokens = Lexer{std::string(quelltext)}.alleTokens();
+    } catch (const ParseError& e) {     // Quelltext zu lang für die 32-Bit-Offsets der Tokens.
+        ergebnis.diagnosen.push_back(zerlege(Diagnose::Art::Syntax, e.what()));
+        return ergebnis;
+    }
+    Parser parser(std::move(tokens));
+    std::unique_ptr<Program> ast;
+    try {
+        ast = parser.parse();
+    } catch (const ParseError& e) {
+        ergebnis.diagnosen.push_back(zerlege(Diagnose::Art::Syntax, e.what()));
+    } catch (const std::exception& e) {      // Keine Ausnahme darf compile verlassen, auch keine unerwartete.
+        ergebnis.diagnosen.push_back({Diagnose::Art::Syntax, 0, std::string("Interner Fehler beim Parsen: ") + e.what()});
+    }
+    for (auto& fehler : parser.fehler()) {
+        ergebnis.diagnosen.push_back(zerlege(Diagnose::Art::Syntax, fehler));
+    }
+    if (!ergebnis.ok()) return ergebnis;
+
+    for (auto& stmt : ast->statements) {
+        if (auto id = dynamic_cast<ImportDeclaration*>(stmt.get())) {
+            ergebnis.mitModulen = true;
+            ergebnis.diagnosen.push_back({Diagnose::Art::Modul, id->zeile, "HOLE ... VON \"" + id->modul + "\" braucht Dateien; Programme mit Modulen übersetzt nur gppc"});
+        }
+    }
+    if (!ergebnis.ok()) return ergebnis;
+
+    GeneratorOptionen generatorOptionen;
+    generatorOptionen.quellDatei = optionen.quellDatei;
+    generatorOptionen.profil = optionen.profil || optionen.profilSchleifen;
+    generatorOptionen.profilSchleifen = optionen.profilSchleifen;
+    generatorOptionen.threads = optionen.threads;
+    generatorOptionen.konstant = !generatorOptionen.profil;     // Die Messpunkte von --profile vertragen sich nicht mit constexpr-Funktionen.
+
+    Analyzer analyzer;
+    AnalyseErgebnis analyse;
+    try {
+        analyse = analyzer.analysiere(ast.get());
+    } catch (const SemanticError& e) {
+        ergebnis.diagnosen.push_back(zerlege(Diagnose::Art::Semantik, e.what()));
+        return ergebnis;
+    } catch (const std::exception& e) {
+        ergebnis.diagnosen.push_back({Diagnose::Art::Semantik, 0, std::string("Interner Fehler bei der Analyse: ") + e.what()});
+        return ergebnis;
+    }
+    if (optionen.constexprBericht) {
+        ergebnis.constexprBericht = constexprBericht(analyse, generatorOptionen.konstant);
+    }
+    if (optionen.vektorBericht) {
+        ergebnis.vektorBericht = vektorBericht(analyse);
+    }
+
+    Generator generator(std::move(ast), std::move(analyse), generatorOptionen);
+    try {
+        if (ziel != nullptr) {
+            // Erst vollständig im Speicher erzeugen: Bricht der Generator ab, bekommt `ziel` nichts.
+            SpeicherAusgabe code;
+            generator.generate(code);
+            code.uebertrageNach(*ziel);
+        } else {
+            ergebnis.cpp = generator.generate();
+        }
+    } catch (const std::exception& e) {
+        ergebnis.cpp.clear();
+        ergebnis.diagnosen.push_back({Diagnose::Art::Semantik, 0, std::string("Interner Fehler bei der Codeerzeugung: ") + e.what()});
+    }
+    return ergebnis;
+}
+
+}
+
+std::string Diagnose::meldung() const {
+    return zeile > 0 ? "Zeile " + std::to_string(zeile) + ": " + text : text;
+}
+
+Ergebnis compile(std::string_view quelltext, const Optionen& optionen) {
+    return uebersetze(quelltext, optionen, nullptr);
+}
+
+Ergebnis compile(std::string_view quelltext, const Optionen& optionen, Ausgabe& ziel) {
+    return uebersetze(quelltext, optionen, &ziel);
+}
+
+}
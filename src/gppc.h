@@ -0,0 +1,62 @@
+#pragma once
+
+/*
+ * gppc.h - Der Compiler als Bibliothek (libgppc.a).
+ *
+ * gppc::compile übersetzt GerLang-Quelltext im selben Prozess nach C++, ohne Dateien und
+ * ohne g++: Lexer, Parser, Analyse und Generator, wie sie auch das Programm gppc benutzt.
+ * Jeder Aufruf hat seinen eigenen Zustand; es gibt keine veränderlichen globalen Variablen,
+ * daher darf compile gleichzeitig aus beliebig vielen Threads aufgerufen werden.
+ * Fehler kommen als Diagnosen im Ergebnis zurück, nicht als Ausnahmen und nicht auf der Konsole.
+ *
+ *     gppc::Ergebnis e = gppc::compile("GANZ haupt() { DRUCKE(1); ZURUECK 0; }");
+ *     if (e.ok()) baue(e.cpp); else for (auto& d : e.diagnosen) melde(d.zeile, d.text);
+ *
+ * Der Code braucht zum Übersetzen runtime/gerlang.h und zum Linken libgerlang.a; mit -fopenmp-simd
+ * wirkt `#pragma omp simd` vor Schleifen, deren Durchläufe nicht voneinander abhängen.
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Ausgabe;
+
+namespace gppc {
+
+struct Optionen {
+    std::string quellDatei;         // Pfad der .gc-Datei für #line-Direktiven; leer = keine.
+    bool profil = false;            // Wie gppc --profile.
+    bool profilSchleifen = false;   // Wie gppc --profile-schleifen (schließt profil ein).
+    bool constexprBericht = false;  // Ergebnis::constexprBericht füllen (wie gppc --constexpr-bericht).
+    bool vektorBericht = false;     // Ergebnis::vektorBericht füllen (wie gppc --vektor-bericht).
+    unsigned threads = 1;           // Threads für die Codeerzeugung dieses Aufrufs; 0 = alle Kerne. Standard 1, weil Aufrufer meist selbst parallel übersetzen.
+};
+
+struct Diagnose {
+    enum class Art { Syntax, Semantik, Modul };
+    Art art;
+    int zeile = 0;                  // Zeile im Quelltext (ab 1); 0, wenn die Meldung zu keiner Zeile gehört.
+    std::string text;               // Meldung ohne "Zeile N: ".
+
+    std::string meldung() const;    // "Zeile N: text" bzw. nur der Text, so wie gppc sie ausgibt.
+};
+
+struct Ergebnis {
+    std::string cpp;                        // Der generierte C++-Code; leer bei Fehlern oder wenn er an ein Ausgabe-Ziel ging.
+    std::vector<Diagnose> diagnosen;        // Alle gefundenen Fehler; leer bei Erfolg.
+    std::string constexprBericht;           // Mit Optionen::constexprBericht: der Bericht als Text, eine Zeile pro Eintrag.
+    std::string vektorBericht;              // Mit Optionen::vektorBericht: jede FUER-Schleife mit `#pragma omp simd` oder dem Grund, warum nicht.
+    bool mitModulen = false;                // Das Programm importiert Module mit HOLE; die kann nur gppc (mit Dateien) übersetzen.
+
+    bool ok() const { return diagnosen.empty(); }
+};
+
+Ergebnis compile(std::string_view quelltext, const Optionen& optionen = {});
+
+// Wie oben, aber der Code geht nach `ziel` (z.B. direkt in die Standardeingabe von g++, siehe
+// ausgabe.h) statt nach Ergebnis::cpp. `ziel` bekommt nur etwas, wenn es keine Diagnosen gibt: Der
+// Code entsteht erst vollständig im Speicher und wird dann in einem Stück übergeben.
+Ergebnis compile(std::string_view quelltext, const Optionen& optionen, Ausgabe& ziel);
+
+}
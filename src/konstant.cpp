@@ -0,0 +1,264 @@
+#include "konstant.h"
+#include <cfloat>
+#include <charconv>
+#include <climits>
+#include <cmath>
+
+KonstantAuswerter::KonstantAuswerter(const std::map<std::string, FunctionDeclaration*>& funktionen)
+    : m_funktionen(funktionen) {}
+
+std::string KonstantAuswerter::pruefe(CallExpression* aufruf) {        // Wertet die Argumente und dann den Aufruf aus; Ergebnisse gleicher Aufrufe werden wiederverwendet.
+    auto name = dynamic_cast<IdentifierExpression*>(aufruf->aufrufer.get());
+    if (name == nullptr) return "kein direkter Funktionsaufruf";
+    try {
+        m_schritte = 0;
+        std::vector<Wert> argumente;
+        std::string schluessel = name->name + "(";
+        for (auto& arg : aufruf->argumente) {
+            argumente.push_back(werte(arg.get()));
+            const Wert& w = argumente.back();
+            if (w.typ == 'K') {
+                char puffer[32];
+                schluessel.append(puffer, std::to_chars(puffer, puffer + sizeof(puffer), w.komma).ptr);    // Kürzeste exakte Darstellung.
+            } else {
+                schluessel += std::to_string(w.ganz);
+            }
+            schluessel += w.typ;
+            schluessel += ",";
+        }
+        schluessel += ")";
+        auto bekannt = m_ergebnisse.find(schluessel);
+        if (bekannt != m_ergebnisse.end()) return bekannt->second;
+        try {
+            rufe(name->name, argumente);
+            m_ergebnisse[schluessel] = "";
+        } catch (const Abbruch& a) {
+            m_ergebnisse[schluessel] = a.grund;
+        }
+        return m_ergebnisse[schluessel];
+    } catch (const Abbruch& a) {
+        return a.grund;
+    }
+}
+
+void KonstantAuswerter::schritt() {        // Zählt einen Auswertungsschritt gegen das Budget.
+    if (++m_schritte > BUDGET) {
+        throw Abbruch{"mehr als " + std::to_string(BUDGET) + " Schritte"};
+    }
+}
+
+KonstantAuswerter::Wert KonstantAuswerter::wandle(const Wert& wert, const std::string& typ) {      // Implizite Umwandlung wie in C++ bei Zuweisung, Parameterübergabe und ZURUECK.
+    Wert ergebnis;
+    double zahl = wert.typ == 'K' ? wert.komma : static_cast<double>(wert.ganz);
+    if (typ == "GANZ") {
+        if (wert.typ == 'K' && !(zahl > INT_MIN - 1.0 && zahl < INT_MAX + 1.0)) {
+            throw Abbruch{"KOMMA-Wert passt nicht in GANZ"};
+        }
+        ergebnis.typ = 'G';
+        ergebnis.ganz = wert.typ == 'K' ? static_cast<long long>(zahl) : wert.ganz;
+    } else if (typ == "KOMMA") {
+        if (std::fabs(zahl) > FLT_MAX) throw Abbruch{"KOMMA-Überlauf"};
+        ergebnis.typ = 'K';
+        ergebnis.komma = static_cast<float>(zahl);
+    } else {
+        ergebnis.typ = 'J';
+        ergebnis.ganz = zahl != 0;
+    }
+    return ergebnis;
+}
+
+KonstantAuswerter::Wert& KonstantAuswerter::variable(const std::string& name) {     // Sucht eine Variable vom innersten Block bis zum Anfang des aktuellen Aufrufs.
+    for (std::size_t i = m_rahmen.size(); i > m_aufrufBasis.back(); --i) {
+        auto gefunden = m_rahmen[i - 1].find(name);
+        if (gefunden != m_rahmen[i - 1].end()) return gefunden->second;
+    }
+    throw Abbruch{"unbekannte Variable '" + name + "'"};
+}
+
+KonstantAuswerter::Wert KonstantAuswerter::rufe(const std::string& name, const std::vector<Wert>& argumente) {      // Führt eine Funktion in einem neuen Rahmen aus.
+    schritt();
+    auto gefunden = m_funktionen.find(name);
+    if (gefunden == m_funktionen.end()) throw Abbruch{"'" + name + "' ist nicht constexpr"};
+    FunctionDeclaration* fd = gefunden->second;
+    if (m_aufrufBasis.size() >= TIEFE) throw Abbruch{"Rekursion tiefer als " + std::to_string(TIEFE)};
+    if (argumente.size() != fd->parameter.size()) throw Abbruch{"falsche Anzahl Argumente für '" + name + "'"};
+
+    m_aufrufBasis.push_back(m_rahmen.size());
+    m_rahmen.emplace_back();
+    for (std::size_t i = 0; i < argumente.size(); ++i) {
+        m_rahmen.back()[fd->parameter[i].second] = wandle(argumente[i], fd->parameter[i].first);
+    }
+    Wert rueckgabe;
+    bool zurueck = false;
+    try {
+        zurueck = fuehreAus(fd->body.get(), rueckgabe);
+    } catch (...) {
+        m_rahmen.resize(m_aufrufBasis.back());
+        m_aufrufBasis.pop_back();
+        throw;
+    }
+    m_rahmen.resize(m_aufrufBasis.back());
+    m_aufrufBasis.pop_back();
+    if (!zurueck) throw Abbruch{"'" + name + "' endet ohne ZURUECK"};
+    return wandle(rueckgabe, fd->returnTyp);
+}
+
+bool KonstantAuswerter::fuehreAus(Statement* stmt, Wert& rueckgabe) {      // Führt ein Statement aus; true, sobald ZURUECK erreicht ist.
+    schritt();
+    if (stmt == nullptr) return false;
+    if (auto bs = dynamic_cast<BlockStatement*>(stmt)) {
+        m_rahmen.emplace_back();
+        bool zurueck = false;
+        for (auto& s : bs->statements) {
+            if (fuehreAus(s.get(), rueckgabe)) {
+                zurueck = true;
+                break;
+            }
+        }
+        m_rahmen.pop_back();
+        return zurueck;
+    }
+    if (auto vd = dynamic_cast<VariableDeclaration*>(stmt)) {
+        m_rahmen.back()[vd->name] = wandle(werte(vd->initializer.get()), vd->typName);
+        return false;
+    }
+    if (auto as = dynamic_cast<AssignmentStatement*>(stmt)) {
+        Wert& ziel = variable(as->name);
+        std::string typ = ziel.typ == 'G' ? "GANZ" : ziel.typ == 'K' ? "KOMMA" : "JAIN";
+        ziel = wandle(werte(as->wert.get()), typ);
+        return false;
+    }
+    if (auto rs = dynamic_cast<ReturnStatement*>(stmt)) {
+        rueckgabe = werte(rs->wert.get());
+        return true;
+    }
+    if (auto is = dynamic_cast<IfStatement*>(stmt)) {
+        if (wandle(werte(is->condition.get()), "JAIN").ganz) return fuehreAus(is->thenBranch.get(), rueckgabe);
+        return fuehreAus(is->elseBranch.get(), rueckgabe);
+    }
+    if (auto ws = dynamic_cast<WhileStatement*>(stmt)) {
+        while (wandle(werte(ws->condition.get()), "JAIN").ganz) {
+            if (fuehreAus(ws->body.get(), rueckgabe)) return true;
+        }
+        return false;
+    }
+    if (auto fs = dynamic_cast<ForStatement*>(stmt)) {
+        m_rahmen.emplace_back();
+        bool zurueck = false;
+        fuehreAus(fs->initializer.get(), rueckgabe);
+        while (fs->condition == nullptr || wandle(werte(fs->condition.get()), "JAIN").ganz) {
+            if (fuehreAus(fs->body.get(), rueckgabe)) {
+                zurueck = true;
+                break;
+            }
+            fuehreAus(fs->increment.get(), rueckgabe);
+        }
+        m_rahmen.pop_back();
+        return zurueck;
+    }
+    throw Abbruch{"Anweisung ist nicht constexpr"};
+}
+
+KonstantAuswerter::Wert KonstantAuswerter::werte(Expression* expr) {       // Wertet einen Ausdruck mit den Regeln von C++ aus und bricht bei undefiniertem Verhalten ab.
+    schritt();
+    if (auto le = dynamic_cast<LiteralExpression*>(expr)) {
+        Wert w;
+        if (le->typName == "GANZ") {
+            w.ganz = std::any_cast<int>(le->wert);
+        } else if (le->typName == "KOMMA") {
+            w.typ = 'K';
+            w.komma = std::any_cast<float>(le->wert);
+        } else if (le->typName == "JAIN") {
+            w.typ = 'J';
+            w.ganz = std::any_cast<bool>(le->wert);
+        } else {
+            throw Abbruch{"WORT ist nicht constexpr"};
+        }
+        return w;
+    }
+    if (auto ie = dynamic_cast<IdentifierExpression*>(expr)) {
+        return variable(ie->name);
+    }
+    if (auto ue = dynamic_cast<UnaryExpression*>(expr)) {
+        Wert w = werte(ue->rechts.get());
+        if (ue->op == "!" || ue->op == "NICHT") {
+            Wert j = wandle(w, "JAIN");
+            j.ganz = !j.ganz;
+            return j;
+        }
+        if (w.typ == 'K') {
+            w.komma = -w.komma;
+            return w;
+        }
+        if (w.ganz == INT_MIN) throw Abbruch{"GANZ-Überlauf"};
+        w.typ = 'G';
+        w.ganz = -w.ganz;
+        return w;
+    }
+    if (auto be = dynamic_cast<BinaryExpression*>(expr)) {
+        const std::string& op = be->op;
+        if (op == "UND" || op == "ODER") {
+            bool links = wandle(werte(be->links.get()), "JAIN").ganz;
+            if (op == "UND" && !links) return wandle(Wert{'J', 0, 0}, "JAIN");
+            if (op == "ODER" && links) return wandle(Wert{'J', 1, 0}, "JAIN");
+            return wandle(werte(be->rechts.get()), "JAIN");
+        }
+        Wert l = werte(be->links.get());
+        Wert r = werte(be->rechts.get());
+        Wert ergebnis;
+        if (l.typ == 'K' || r.typ == 'K') {
+            float a = l.typ == 'K' ? l.komma : static_cast<float>(l.ganz);
+            float b = r.typ == 'K' ? r.komma : static_cast<float>(r.ganz);
+            ergebnis.typ = 'J';
+            if (op == "==") ergebnis.ganz = a == b;
+            else if (op == "!=") ergebnis.ganz = a != b;
+            else if (op == "<") ergebnis.ganz = a < b;
+            else if (op == ">") ergebnis.ganz = a > b;
+            else if (op == "<=") ergebnis.ganz = a <= b;
+            else if (op == ">=") ergebnis.ganz = a >= b;
+            else {
+                ergebnis.typ = 'K';
+                if (op == "+") ergebnis.komma = a + b;
+                else if (op == "-") ergebnis.komma = a - b;
+                else if (op == "*") ergebnis.komma = a * b;
+                else if (op == "/" && b != 0) ergebnis.komma = a / b;
+                else if (op == "/") throw Abbruch{"Division durch 0"};
+                else throw Abbruch{"Operator '" + op + "' gibt es für KOMMA nicht"};
+                if (!std::isfinite(ergebnis.komma)) throw Abbruch{"KOMMA-Überlauf"};
+            }
+            return ergebnis;
+        }
+        long long a = l.ganz;
+        long long b = r.ganz;
+        ergebnis.typ = 'J';
+        if (op == "==") ergebnis.ganz = a == b;
+        else if (op == "!=") ergebnis.ganz = a != b;
+        else if (op == "<") ergebnis.ganz = a < b;
+        else if (op == ">") ergebnis.ganz = a > b;
+        else if (op == "<=") ergebnis.ganz = a <= b;
+        else if (op == ">=") ergebnis.ganz = a >= b;
+        else {
+            ergebnis.typ = 'G';
+            if (op == "+") ergebnis.ganz = a + b;
+            else if (op == "-") ergebnis.ganz = a - b;
+            else if (op == "*") ergebnis.ganz = a * b;
+            else if ((op == "/" || op == "%") && b == 0) throw Abbruch{"Division durch 0"};
+            else if (op == "%" && a == INT_MIN && b == -1) throw Abbruch{"GANZ-Überlauf"};
+            else if (op == "/") ergebnis.ganz = a / b;
+            else if (op == "%") ergebnis.ganz = a % b;
+            else throw Abbruch{"unbekannter Operator '" + op + "'"};
+            if (ergebnis.ganz < INT_MIN || ergebnis.ganz > INT_MAX) throw Abbruch{"GANZ-Überlauf"};
+        }
+        return ergebnis;
+    }
+    if (auto ce = dynamic_cast<CallExpression*>(expr)) {
+        auto name = dynamic_cast<IdentifierExpression*>(ce->aufrufer.get());
+        if (name == nullptr) throw Abbruch{"kein direkter Funktionsaufruf"};
+        std::vector<Wert> argumente;
+        for (auto& arg : ce->argumente) {
+            argumente.push_back(werte(arg.get()));
+        }
+        return rufe(name->name, argumente);
+    }
+    throw Abbruch{"Ausdruck ist nicht constexpr"};
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ast.h"
+
+// Wertet einen Aufruf einer constexpr-fähigen Funktion mit konstanten Argumenten
+// probeweise aus, bevor der Generator ihn g++ zur Auswertung beim Kompilieren gibt.
+// g++ bricht das Kompilieren ab, wenn die Auswertung zu lange dauert oder auf
+// undefiniertes Verhalten trifft (Überlauf, Division durch 0). Der Auswerter
+// rechnet deshalb mit einem Schrittbudget und meldet genau diese Fälle.
+// Das Ergebnis selbst rechnet g++ aus; KOMMA rechnet der Auswerter wie der erzeugte
+// Code in float, damit ein Überlauf hier genauso auffällt wie bei g++.
+class KonstantAuswerter {
+public:
+    static constexpr long BUDGET = 100000;     // Schritte pro Aufruf (weit unter -fconstexpr-ops-limit).
+    static constexpr int TIEFE = 256;          // Verschachtelte Aufrufe (g++: -fconstexpr-depth=512).
+
+    explicit KonstantAuswerter(const std::map<std::string, FunctionDeclaration*>& funktionen);
+
+    // Leer, wenn der Aufruf gefaltet werden darf, sonst der Grund.
+    std::string pruefe(CallExpression* aufruf);
+
+private:
+    struct Wert {
+        char typ = 'G';         // 'G' = GANZ, 'K' = KOMMA, 'J' = JAIN
+        long long ganz = 0;
+        float komma = 0;
+    };
+
+    struct Abbruch {
+        std::string grund;
+    };
+
+    const std::map<std::string, FunctionDeclaration*>& m_funktionen;
+    std::map<std::string, std::string> m_ergebnisse;       // Bereits geprüfte Aufrufe ("f(3,4)") -> Grund.
+    std::vector<std::map<std::string, Wert>> m_rahmen;      // Variablen je Block des aktuellen Aufrufs.
+    std::vector<std::size_t> m_aufrufBasis;                 // Erster Block jedes aktiven Aufrufs.
+    long m_schritte = 0;
+
+    void schritt();
+    Wert rufe(const std::string& name, const std::vector<Wert>& argumente);
+    bool fuehreAus(Statement* stmt, Wert& rueckgabe);
+    Wert werte(Expression* expr);
+    Wert wandle(const Wert& wert, const std::string& typ);
+    Wert& variable(const std::string& name);
+};
@@ -1,7 +1,10 @@
 #include "lexer.h"
-#include <cctype>
+#include "parser.h"
+#include <array>
+#include <cstdint>
+#include <utility>
 
-std::map<std::string, TokenType> Lexer::keywords = {
+std::map<std::string, TokenType, std::less<>> Lexer::keywords = {
     {"NIX", TokenType::UNBEKANNT},
     {"GANZ", TokenType::GANZ},
     {"KOMMA", TokenType::KOMMA},
@@ -15,23 +18,150 @@ std::map<std::string, TokenType> Lexer::keywords = {
     {"ODER", TokenType::ODER},
     {"NICHT", TokenType::NICHT},
     {"FUER", TokenType::FUER},
+    {"PARALLEL", TokenType::PARALLEL},
+    {"JEDES", TokenType::JEDES},
+    {"IN", TokenType::IN},
+    {"AUFGABE", TokenType::AUFGABE},
+    {"KARTE", TokenType::KARTE},
+    {"SICHT", TokenType::SICHT},
+    {"ZEILEN", TokenType::ZEILEN},
+    {"WARTE", TokenType::WARTE},
+    {"MERKE", TokenType::MERKE},
     {"DRUCKE", TokenType::DRUCKE},
     {"LESE", TokenType::LESE},
+    {"LESE_ALLE", TokenType::LESE_ALLE},
+    {"LEERE", TokenType::LEERE},
     {"ZU_GANZ", TokenType::ZU_GANZ},
     {"ZU_KOMMA", TokenType::ZU_KOMMA},
     {"ZU_WORT", TokenType::ZU_WORT},
     {"ZURUECK", TokenType::ZURUECK},
+    {"LAENGE", TokenType::LAENGE},
+    {"HINZUFUEGEN", TokenType::HINZUFUEGEN},
+    {"SUMME", TokenType::SUMME},
+    {"SORTIERE", TokenType::SORTIERE},
+    {"ENTHAELT", TokenType::ENTHAELT},
+    {"SCHLUESSEL", TokenType::SCHLUESSEL},
+    {"DATEI_LESE", TokenType::DATEI_LESE},
+    {"DATEI_ZEILEN", TokenType::DATEI_ZEILEN},
+    {"DATEI_ENDE", TokenType::DATEI_ENDE},
+    {"DATEI_SCHREIBE", TokenType::DATEI_SCHREIBE},
     {"GIBFREI", TokenType::GIBFREI},
     {"HOLE", TokenType::HOLE},
-    {"VON", TokenType::VON}
+    {"VON", TokenType::VON},
+    {"STRUKTUR", TokenType::STRUKTUR},
+    {"KOMPAKT", TokenType::KOMPAKT}
 };
 
-std::map<std::string, TokenType> Lexer::literals = {
+std::map<std::string, TokenType, std::less<>> Lexer::literals = {
     {"JA", TokenType::BOOL_LITERAL},
     {"NEIN", TokenType::BOOL_LITERAL}
 };
 
-Lexer::Lexer(const std::string& quelltext) : m_quelltext(quelltext) {   // Konstruktor: Initialisiert den Lexer mit dem Quelltext.
+namespace {
+
+// Zeichenklassen für die erste Entscheidung in naechstesToken. Eine Tabelle statt isspace/isalpha:
+// Die <cctype>-Funktionen hängen von der Locale ab und sind für Bytes über 127 (UTF-8) undefiniert.
+enum Klasse : std::uint8_t { SONSTIGES, LEER, ZIFFER, BUCHSTABE, ANFUEHRUNG, UTF8 };
+
+constexpr std::array<std::uint8_t, 256> baueKlassen() {
+    std::array<std::uint8_t, 256> klassen{};
+    for (char c : {' ', '\t', '\n', '\r', '\v', '\f'}) klassen[static_cast<unsigned char>(c)] = LEER;
+    for (int c = '0'; c <= '9'; ++c) klassen[c] = ZIFFER;
+    for (int c = 'a'; c <= 'z'; ++c) klassen[c] = BUCHSTABE;
+    for (int c = 'A'; c <= 'Z'; ++c) klassen[c] = BUCHSTABE;
+    klassen['_'] = BUCHSTABE;
+    klassen['"'] = ANFUEHRUNG;
+    klassen['\''] = ANFUEHRUNG;
+    for (int c = 0x80; c < 0x100; ++c) klassen[c] = UTF8;
+    return klassen;
+}
+
+constexpr std::array<std::uint8_t, 256> KLASSEN = baueKlassen();
+
+// UTF-8 als Automat: Jedes Byte fällt in eine von 12 Arten, der Zustand sagt, welche Folgebytes
+// noch erlaubt sind. Überlange Kodierungen, Surrogate und Werte über U+10FFFF führen nach FEHLER.
+enum Utf8Zustand : std::uint8_t { FERTIG, FEHLER, NOCH_1, NOCH_2, NACH_E0, NACH_ED, NOCH_3, NACH_F0, NACH_F4 };
+
+constexpr std::array<std::uint8_t, 256> baueUtf8Arten() {
+    std::array<std::uint8_t, 256> arten{};
+    for (int b = 0x80; b <= 0x8F; ++b) arten[b] = 1;
+    for (int b = 0x90; b <= 0x9F; ++b) arten[b] = 2;
+    for (int b = 0xA0; b <= 0xBF; ++b) arten[b] = 3;
+    for (int b = 0xC2; b <= 0xDF; ++b) arten[b] = 4;
+    arten[0xE0] = 5;
+    for (int b = 0xE1; b <= 0xEF; ++b) arten[b] = 6;
+    arten[0xED] = 7;
+    arten[0xF0] = 8;
+    for (int b = 0xF1; b <= 0xF3; ++b) arten[b] = 9;
+    arten[0xF4] = 10;
+    arten[0xC0] = arten[0xC1] = 11;
+    for (int b = 0xF5; b <= 0xFF; ++b) arten[b] = 11;
+    return arten;
+}
+
+constexpr std::array<std::uint8_t, 256> UTF8_ARTEN = baueUtf8Arten();
+
+constexpr std::uint8_t LEITMASKE[12] = {0, 0, 0, 0, 0x1F, 0x0F, 0x0F, 0x0F, 0x07, 0x07, 0x07, 0};
+
+constexpr std::uint8_t UTF8_UEBERGANG[9][12] = {
+    // ASCII   80-8F   90-9F   A0-BF   C2-DF   E0       E1-EF   ED       F0       F1-F3   F4       ungültig
+    {FEHLER, FEHLER, FEHLER, FEHLER, NOCH_1, NACH_E0, NOCH_2, NACH_ED, NACH_F0, NOCH_3, NACH_F4, FEHLER},     // FERTIG
+    {FEHLER, FEHLER, FEHLER, FEHLER, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // FEHLER
+    {FEHLER, FERTIG, FERTIG, FERTIG, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // NOCH_1
+    {FEHLER, NOCH_1, NOCH_1, NOCH_1, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // NOCH_2
+    {FEHLER, FEHLER, FEHLER, NOCH_1, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // NACH_E0
+    {FEHLER, NOCH_1, NOCH_1, FEHLER, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // NACH_ED
+    {FEHLER, NOCH_2, NOCH_2, NOCH_2, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // NOCH_3
+    {FEHLER, FEHLER, NOCH_2, NOCH_2, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // NACH_F0
+    {FEHLER, NOCH_2, FEHLER, FEHLER, FEHLER, FEHLER,  FEHLER, FEHLER,  FEHLER,  FEHLER, FEHLER,  FEHLER},     // NACH_F4
+};
+
+// Buchstaben außerhalb von ASCII: die Bereiche, die auch C++ in Bezeichnern erlaubt (der Name landet
+// unverändert im generierten Code), ohne Leer-, Satz- und kombinierende Zeichen.
+constexpr std::pair<char32_t, char32_t> BUCHSTABEN[] = {
+    {0x00AA, 0x00AA}, {0x00B5, 0x00B5}, {0x00BA, 0x00BA}, {0x00C0, 0x00D6}, {0x00D8, 0x00F6},
+    {0x00F8, 0x02FF}, {0x0370, 0x167F}, {0x1681, 0x180D}, {0x180F, 0x1DBF}, {0x1E00, 0x1FFF},
+    {0x2C00, 0x2DFF}, {0x2E80, 0x2FFF}, {0x3040, 0xD7FF}, {0xF900, 0xFD3D}, {0xFD40, 0xFDCF},
+    {0xFDF0, 0xFE1F}, {0xFE30, 0xFE44}, {0xFE47, 0xFFFD}, {0x10000, 0xEFFFD},
+};
+
+bool istBuchstabe(char32_t zeichen) {
+    if ((zeichen & 0xFFFE) == 0xFFFE) return false;     // U+xFFFE und U+xFFFF sind in keiner Ebene Zeichen.
+    for (auto& [von, bis] : BUCHSTABEN) {
+        if (zeichen < von) return false;
+        if (zeichen <= bis) return true;
+    }
+    return false;
+}
+
+std::size_t utf8Zeichen(std::string_view text, std::size_t pos, bool& buchstabe) {     // Länge des UTF-8-Zeichens ab `pos`, 0 bei ungültigem UTF-8. `buchstabe` sagt, ob es in Namen stehen darf.
+    std::uint8_t zustand = FERTIG;
+    char32_t zeichen = 0;
+    for (std::size_t i = pos; i < text.size(); ++i) {
+        std::uint8_t b = static_cast<std::uint8_t>(text[i]);
+        std::uint8_t art = UTF8_ARTEN[b];
+        zeichen = zustand == FERTIG ? (b & LEITMASKE[art]) : (zeichen << 6) | (b & 0x3F);
+        zustand = UTF8_UEBERGANG[zustand][art];
+        if (zustand == FEHLER) return 0;
+        if (zustand == FERTIG) {
+            buchstabe = istBuchstabe(zeichen);
+            return i + 1 - pos;
+        }
+    }
+    return 0;
+}
+
+}
+
+static const std::string& pruefeLaenge(const std::string& quelltext) {      // Ein Quelltext ab 4 GiB passt nicht in die 32-Bit-Offsets der TokenListe; abschneiden würde Tokens und Zeilen verfälschen.
+    if (quelltext.size() > TokenListe::MAXIMALE_LAENGE) {
+        throw ParseError("Der Quelltext ist " + std::to_string(quelltext.size()) + " Bytes groß, erlaubt sind höchstens " +
+                         std::to_string(TokenListe::MAXIMALE_LAENGE));
+    }
+    return quelltext;
+}
+
+Lexer::Lexer(const std::string& quelltext) : m_tokens(pruefeLaenge(quelltext)), m_quelltext(m_tokens.quelltext()) {   // Konstruktor: Initialisiert den Lexer mit dem Quelltext.
     m_aktuellesZeichen = (m_position < m_quelltext.length()) ? m_quelltext[m_position] : '\0';
 }
 
@@ -39,197 +169,196 @@ bool Lexer::isAtEnd() {     // Prüft, ob das Ende des Quelltextes erreicht ist.
     return m_position >= m_quelltext.length();
 }
 
-void Lexer::vorruecken() {      // Bewegt die Leseposition zum nächsten Zeichen und aktualisiert Zeile/Spalte.
+void Lexer::vorruecken() {      // Bewegt die Leseposition zum nächsten Zeichen. Zeile/Spalte berechnet erst die TokenListe bei Bedarf.
     if (isAtEnd()) {
         m_aktuellesZeichen = '\0';
         return;
     }
 
-    if (m_aktuellesZeichen == '\n') {
-        m_zeile++;
-        m_spalte = 1;
-    } else {
-        m_spalte++;
-    }
-
     m_position++;
     m_aktuellesZeichen = (m_position < m_quelltext.length()) ? m_quelltext[m_position] : '\0';
 }
 
+void Lexer::springeZu(std::size_t position) {       // Setzt die Leseposition nach einer Schleife, die direkt über den Quelltext gelaufen ist.
+    m_position = position;
+    m_aktuellesZeichen = (m_position < m_quelltext.length()) ? m_quelltext[m_position] : '\0';
+}
+
 char Lexer::peek() {        // Schaut auf das nächste Zeichen, ohne die Position zu verändern.
-    int naechstePos = m_position + 1;
+    std::size_t naechstePos = m_position + 1;
     if (naechstePos >= m_quelltext.length()) {
         return '\0';
     }
     return m_quelltext[naechstePos];
 }
 
+std::uint8_t Lexer::klasse(std::size_t position) const {       // Zeichenklasse des Bytes an `position`.
+    return KLASSEN[static_cast<unsigned char>(m_quelltext[position])];
+}
+
 void Lexer::skipWhitespace() {      // Überspringt alle Leerzeichen, Tabs und Zeilenumbrüche an der aktuellen Position.
-    while (!isAtEnd() && isspace(m_aktuellesZeichen)) {
-        vorruecken();
-    }
+    std::size_t pos = m_position;
+    while (pos < m_quelltext.size() && klasse(pos) == LEER) ++pos;
+    springeZu(pos);
 }
 
 void Lexer::skipKommentar() {       // Überspringt einen einzeiligen Kommentar (beginnend mit //).
-    if (m_aktuellesZeichen == '/' && peek() == '/') {
-        while (!isAtEnd() && m_aktuellesZeichen != '\n') {
-            vorruecken();
-        }
-        skipWhitespace();
-    }
+    std::size_t ende = m_quelltext.find('\n', m_position);
+    springeZu(ende == std::string_view::npos ? m_quelltext.size() : ende);
 }
 
-void Lexer::skipMultiLineKommentar() {      // Überspringt einen Blockkommentar (zwischen /* und */).
-    vorruecken();
-    vorruecken();
-    
-    while (!isAtEnd()) {
-        if (m_aktuellesZeichen == '*' && peek() == '/') {
-            break;
-        }
-        vorruecken();
-    }
-    
-    if (!isAtEnd()) {
-        vorruecken();
-        vorruecken();
-    }
-    
-    skipWhitespace();
+void Lexer::skipMultiLineKommentar() {      // Überspringt einen Blockkommentar (zwischen /* und */). Ein nicht geschlossener reicht bis zum Dateiende.
+    std::size_t ende = m_quelltext.find("*/", m_position + 2);
+    springeZu(ende == std::string_view::npos ? m_quelltext.size() : ende + 2);
+}
+
+TokenType Lexer::neuesToken(TokenType typ, std::size_t start) {       // Hängt das Token von `start` bis zur aktuellen Position an die Liste an.
+    m_tokens.hinzufuegen(typ, static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(m_position - start));
+    return typ;
 }
 
-Token Lexer::erkenneZahl() {        // Liest eine Ganzzahl (INT_LITERAL) oder Kommazahl (FLOAT_LITERAL).
-    std::string wert;
-    int startSpalte = m_spalte;
+TokenType Lexer::erkenneZahl() {        // Liest eine Ganzzahl (INT_LITERAL) oder Kommazahl (FLOAT_LITERAL).
+    std::size_t start = m_position;
+    std::size_t pos = m_position;
     bool hatPunkt = false;
 
-    while (!isAtEnd() && (isdigit(m_aktuellesZeichen) || m_aktuellesZeichen == '.')) {
-        if (m_aktuellesZeichen == '.') {
-            if (hatPunkt) break;
+    while (pos < m_quelltext.size()) {
+        if (klasse(pos) == ZIFFER) {
+            ++pos;
+        } else if (m_quelltext[pos] == '.' && !hatPunkt) {
             hatPunkt = true;
+            ++pos;
+        } else {
+            break;
         }
-        wert += m_aktuellesZeichen;
-        vorruecken();
     }
+    springeZu(pos);
 
     if (hatPunkt) {
-        return Token(TokenType::FLOAT_LITERAL, wert, m_zeile, startSpalte);
+        return neuesToken(TokenType::FLOAT_LITERAL, start);
     }
-    return Token(TokenType::INT_LITERAL, wert, m_zeile, startSpalte);
+    return neuesToken(TokenType::INT_LITERAL, start);
 }
 
-Token Lexer::erkenneString() {      // Liest einen String-Literal, der in " oder ' eingeschlossen ist.
-    int startSpalte = m_spalte;
-    char quote = m_aktuellesZeichen;
-    vorruecken();
-    
-    std::string wert;
-    while (!isAtEnd() && m_aktuellesZeichen != quote) {
-        wert += m_aktuellesZeichen;
-        vorruecken();
-    }
-    
-    if (isAtEnd()) {
-        return Token(TokenType::UNBEKANNT, "Fehler: String nicht geschlossen", m_zeile, startSpalte);
+TokenType Lexer::erkenneString() {      // Liest einen String-Literal, der in " oder ' eingeschlossen ist. Das Token umfasst nur den Inhalt ohne Anführungszeichen.
+    std::size_t anfuehrung = m_position;
+    std::size_t ende = m_quelltext.find(m_aktuellesZeichen, anfuehrung + 1);
+
+    if (ende == std::string_view::npos) {
+        springeZu(m_quelltext.size());
+        m_tokens.hinzufuegen(TokenType::UNBEKANNT, static_cast<std::uint32_t>(anfuehrung), 1);     // Nicht geschlossener String.
+        return TokenType::UNBEKANNT;
     }
-    
+
+    springeZu(ende);
+    neuesToken(TokenType::STRING_LITERAL, anfuehrung + 1);
     vorruecken();
-    return Token(TokenType::STRING_LITERAL, wert, m_zeile, startSpalte);
+    return TokenType::STRING_LITERAL;
 }
 
-Token Lexer::erkenneIdentifierOderKeyword() {       // Liest ein Wort und prüft, ob es ein Keyword (wie WENN) oder ein normaler Identifier (Variablenname) ist.
-    std::string wert;
-    int startSpalte = m_spalte;
-    
-    while (!isAtEnd() && (isalnum(m_aktuellesZeichen) || m_aktuellesZeichen == '_')) {
-        wert += m_aktuellesZeichen;
-        vorruecken();
+TokenType Lexer::erkenneIdentifierOderKeyword() {       // Liest ein Wort und prüft, ob es ein Keyword (wie WENN) oder ein normaler Identifier (Variablenname) ist. Namen dürfen UTF-8-Buchstaben enthalten (größe, zähler).
+    std::size_t start = m_position;
+    std::size_t pos = m_position;
+
+    while (pos < m_quelltext.size()) {
+        std::uint8_t k = klasse(pos);
+        if (k == BUCHSTABE || k == ZIFFER) {
+            ++pos;
+            continue;
+        }
+        bool buchstabe = false;
+        std::size_t laenge = k == UTF8 ? utf8Zeichen(m_quelltext, pos, buchstabe) : 0;
+        if (laenge == 0 || !buchstabe) break;
+        pos += laenge;
     }
+    springeZu(pos);
 
-    if (keywords.count(wert)) {
-        return Token(keywords[wert], wert, m_zeile, startSpalte);
+    std::string_view wert = m_quelltext.substr(start, m_position - start);
+    auto keyword = keywords.find(wert);
+    if (keyword != keywords.end()) {
+        return neuesToken(keyword->second, start);
     }
-    if (literals.count(wert)) {
-        return Token(literals[wert], wert, m_zeile, startSpalte);
+    auto literal = literals.find(wert);
+    if (literal != literals.end()) {
+        return neuesToken(literal->second, start);
     }
     
-    return Token(TokenType::IDENTIFIER, wert, m_zeile, startSpalte);
+    return neuesToken(TokenType::IDENTIFIER, start);
 }
 
-Token Lexer::naechstesToken() {     // Die Haupt-Scan-Funktion. Identifiziert und gibt das nächste Token aus dem Quelltext zurück, überspringt Leerzeichen und Kommentare.
+TokenType Lexer::naechstesToken() {     // Die Haupt-Scan-Funktion. Erkennt das nächste Token, hängt es an die Liste an und liefert seine Art; überspringt Leerzeichen und Kommentare. Die Zeichenklasse aus der Tabelle entscheidet, welcher Erkenner zuständig ist.
     while (!isAtEnd()) {
-        if (isspace(m_aktuellesZeichen)) {
-            skipWhitespace();
-            continue;
+        std::size_t start = m_position;
+        switch (klasse(m_position)) {
+            case LEER:
+                skipWhitespace();
+                continue;
+            case ZIFFER:
+                return erkenneZahl();
+            case ANFUEHRUNG:
+                return erkenneString();
+            case BUCHSTABE:
+                return erkenneIdentifierOderKeyword();
+            case UTF8: {
+                bool buchstabe = false;
+                std::size_t laenge = utf8Zeichen(m_quelltext, m_position, buchstabe);
+                if (buchstabe) return erkenneIdentifierOderKeyword();
+                springeZu(m_position + (laenge > 0 ? laenge : 1));      // Ganzes Zeichen (z.B. „ oder €) bzw. ein ungültiges Byte.
+                return neuesToken(TokenType::UNBEKANNT, start);
+            }
+            default:
+                break;
         }
 
-        if (m_aktuellesZeichen == '/' && peek() == '/') {
+        char c = m_aktuellesZeichen;
+        char p = peek();
+
+        if (c == '/' && p == '/') {
             skipKommentar();
             continue;
         }
-
-        if (m_aktuellesZeichen == '/' && peek() == '*') {
+        if (c == '/' && p == '*') {
             skipMultiLineKommentar();
             continue;
         }
 
-        if (isdigit(m_aktuellesZeichen)) {
-            return erkenneZahl();
-        }
-
-        if (m_aktuellesZeichen == '"' || m_aktuellesZeichen == '\'') {
-            return erkenneString();
-        }
-        
-        if (isalpha(m_aktuellesZeichen) || m_aktuellesZeichen == '_') {
-            return erkenneIdentifierOderKeyword();
-        }
-
-        int startSpalte = m_spalte;
-        char c = m_aktuellesZeichen;
-        char p = peek();
-
-        if (c == '=' && p == '=') { vorruecken(); vorruecken(); return Token(TokenType::EQ, "==", m_zeile, startSpalte); }
-        if (c == '!' && p == '=') { vorruecken(); vorruecken(); return Token(TokenType::NEQ, "!=", m_zeile, startSpalte); }
-        if (c == '<' && p == '=') { vorruecken(); vorruecken(); return Token(TokenType::LTE, "<=", m_zeile, startSpalte); }
-        if (c == '>' && p == '=') { vorruecken(); vorruecken(); return Token(TokenType::GTE, ">=", m_zeile, startSpalte); }
+        if (c == '=' && p == '=') { vorruecken(); vorruecken(); return neuesToken(TokenType::EQ, start); }
+        if (c == '!' && p == '=') { vorruecken(); vorruecken(); return neuesToken(TokenType::NEQ, start); }
+        if (c == '<' && p == '=') { vorruecken(); vorruecken(); return neuesToken(TokenType::LTE, start); }
+        if (c == '>' && p == '=') { vorruecken(); vorruecken(); return neuesToken(TokenType::GTE, start); }
 
         vorruecken();
         switch (c) {
-            case '(': return Token(TokenType::LPAREN, "(", m_zeile, startSpalte);
-            case ')': return Token(TokenType::RPAREN, ")", m_zeile, startSpalte);
-            case '{': return Token(TokenType::LBRACE, "{", m_zeile, startSpalte);
-            case '}': return Token(TokenType::RBRACE, "}", m_zeile, startSpalte);
-            case '[': return Token(TokenType::LBRACKET, "[", m_zeile, startSpalte);
-            case ']': return Token(TokenType::RBRACKET, "]", m_zeile, startSpalte);
-            case ';': return Token(TokenType::SEMICOLON, ";", m_zeile, startSpalte);
-            case ',': return Token(TokenType::COMMA, ",", m_zeile, startSpalte);
-            case '.': return Token(TokenType::DOT, ".", m_zeile, startSpalte);
-            case '+': return Token(TokenType::PLUS, "+", m_zeile, startSpalte);
-            case '-': return Token(TokenType::MINUS, "-", m_zeile, startSpalte);
-            case '*': return Token(TokenType::MULTIPLY, "*", m_zeile, startSpalte);
-            case '/': return Token(TokenType::DIVIDE, "/", m_zeile, startSpalte);
-            case '%': return Token(TokenType::MODULO, "%", m_zeile, startSpalte);
-            case '=': return Token(TokenType::ASSIGN, "=", m_zeile, startSpalte);
-            case '<': return Token(TokenType::LT, "<", m_zeile, startSpalte);
-            case '>': return Token(TokenType::GT, ">", m_zeile, startSpalte);
-            case '!': return Token(TokenType::NOT, "!", m_zeile, startSpalte);
-            case ':': return Token(TokenType::COLON, ":", m_zeile, startSpalte);
+            case '(': return neuesToken(TokenType::LPAREN, start);
+            case ')': return neuesToken(TokenType::RPAREN, start);
+            case '{': return neuesToken(TokenType::LBRACE, start);
+            case '}': return neuesToken(TokenType::RBRACE, start);
+            case '[': return neuesToken(TokenType::LBRACKET, start);
+            case ']': return neuesToken(TokenType::RBRACKET, start);
+            case ';': return neuesToken(TokenType::SEMICOLON, start);
+            case ',': return neuesToken(TokenType::COMMA, start);
+            case '.': return neuesToken(TokenType::DOT, start);
+            case '+': return neuesToken(TokenType::PLUS, start);
+            case '-': return neuesToken(TokenType::MINUS, start);
+            case '*': return neuesToken(TokenType::MULTIPLY, start);
+            case '/': return neuesToken(TokenType::DIVIDE, start);
+            case '%': return neuesToken(TokenType::MODULO, start);
+            case '=': return neuesToken(TokenType::ASSIGN, start);
+            case '<': return neuesToken(TokenType::LT, start);
+            case '>': return neuesToken(TokenType::GT, start);
+            case '!': return neuesToken(TokenType::NOT, start);
+            case ':': return neuesToken(TokenType::COLON, start);
         }
 
-        return Token(TokenType::UNBEKANNT, std::string(1, c), m_zeile, startSpalte);
+        return neuesToken(TokenType::UNBEKANNT, start);
     }
     
-    return Token(TokenType::DATEIENDE, "EOF", m_zeile, m_spalte);
+    return neuesToken(TokenType::DATEIENDE, m_position);
 }
 
-std::vector<Token> Lexer::alleTokens() {      // Ruft `naechstesToken` wiederholt auf, bis der gesamte Quelltext in eine Liste von Tokens umgewandelt wurde.
-    std::vector<Token> tokens;
-    Token t = naechstesToken();
-    while (t.typ != TokenType::DATEIENDE) {
-        tokens.push_back(t);
-        t = naechstesToken();
-    }
-    tokens.push_back(t);
-    return tokens;
+TokenListe Lexer::alleTokens() {      // Ruft `naechstesToken` wiederholt auf, bis der gesamte Quelltext zerlegt ist. Darf nur einmal aufgerufen werden, die Liste wird herausgegeben.
+    m_tokens.reserve(m_quelltext.size() / 4 + 1);
+    while (naechstesToken() != TokenType::DATEIENDE) {}
+    m_quelltext = std::string_view();
+    return std::move(m_tokens);
 }
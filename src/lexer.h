@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include "token.h"
@@ -7,28 +9,30 @@
 class Lexer {
 public:
     Lexer(const std::string& quelltext);
-    std::vector<Token> alleTokens();
+    TokenListe alleTokens();
 
 private:
-    std::string m_quelltext;
-    int m_position = 0;
-    int m_zeile = 1;
-    int m_spalte = 1;
+    TokenListe m_tokens;
+    std::string_view m_quelltext;       // Zeigt in den Quelltext von m_tokens.
+    std::size_t m_position = 0;
     char m_aktuellesZeichen;
 
-    static std::map<std::string, TokenType> keywords;
-    static std::map<std::string, TokenType> literals;
+    static std::map<std::string, TokenType, std::less<>> keywords;
+    static std::map<std::string, TokenType, std::less<>> literals;
 
     void vorruecken();
+    void springeZu(std::size_t position);
     char peek();
     bool isAtEnd();
+    std::uint8_t klasse(std::size_t position) const;
     
-    Token naechstesToken();
+    TokenType naechstesToken();
+    TokenType neuesToken(TokenType typ, std::size_t start);
     
-    Token erkenneZahl();
-    Token erkenneIdentifierOderKeyword();
-    Token erkenneString();
+    TokenType erkenneZahl();
+    TokenType erkenneIdentifierOderKeyword();
+    TokenType erkenneString();
     void skipWhitespace();
     void skipKommentar();
     void skipMultiLineKommentar();
-};
\ No newline at end of file
+};
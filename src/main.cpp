@@ -6,13 +6,100 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <csignal>
 #include <cstdlib>
+#include <filesystem>
 
-#include "token.h"
-#include "lexer.h"
+#include "gppc.h"
 #include "parser.h"
-#include "ast.h"
-#include "generator.h"
+#include "module.h"
+#include "ausgabe.h"
+
+// Pfade zur Laufzeitbibliothek (runtime/gerlang.h, libgerlang.a), vom Makefile gesetzt.
+#ifndef GERLANG_RUNTIME_INCLUDE
+#define GERLANG_RUNTIME_INCLUDE "runtime"
+#endif
+#ifndef GERLANG_RUNTIME_LIB
+#define GERLANG_RUNTIME_LIB "."
+#endif
+
+// --pgo-train / --pgo-use: Der generierte Code und das Profil liegen in .gppc_pgo/<programm>/
+// neben dem Programm. Beide Stufen übersetzen dieselbe Datei zu derselben Objektdatei,
+// denn g++ sucht das Profil (quelle.gcda) anhand des Objektnamens.
+// Rückgabe: 0 = Erfolg, 1 = g++ fehlgeschlagen, 2 = Training ohne Profil (bereits gemeldet).
+static int kompiliereMitPgo(bool training, const std::string& trainingsBefehl, const std::string& cppCode,
+                            const std::string& outputName, const std::string& flags) {
+    namespace fs = std::filesystem;
+    fs::path ziel = fs::absolute(outputName);
+    fs::path ordner = ziel.parent_path() / ".gppc_pgo" / ziel.filename();
+    fs::create_directories(ordner);
+    fs::path quelle = ordner / "quelle.cpp";
+    fs::path objekt = ordner / "quelle.o";
+    fs::path profil = ordner / "quelle.gcda";
+    fs::path hashDatei = ordner / "quelle.hash";
+    std::string hash = quellHash(cppCode + flags);
+
+    std::ofstream(quelle) << cppCode;
+
+    std::string pgoFlags;
+    if (training) {
+        fs::remove(profil);
+        pgoFlags = " -fprofile-generate -fprofile-update=prefer-atomic";
+    } else {
+        std::string alterHash;
+        std::ifstream(hashDatei) >> alterHash;
+        if (!fs::exists(profil)) {
+            std::cerr << "-> [gppc] Warnung: Kein PGO-Profil in '" << ordner.string() << "'. Erst mit --pgo-train trainieren. Kompiliere ohne Profil." << std::endl;
+        } else if (alterHash != hash) {
+            std::cerr << "-> [gppc] Warnung: Das PGO-Profil ist veraltet, der generierte Code hat sich seit dem Training geändert. "
+                      << "Kompiliere ohne Profil; bitte --pgo-train erneut ausführen." << std::endl;
+        } else {
+            pgoFlags = " -fprofile-use -fprofile-partial-training";     // Nicht trainierter Code wird normal optimiert statt auf Größe.
+        }
+    }
+
+    std::string kompilieren = "g++ -c \"" + quelle.string() + "\" -o \"" + objekt.string() + "\"" + flags + pgoFlags +
+                              " -I\"" GERLANG_RUNTIME_INCLUDE "\"";
+    std::string linken = "g++ \"" + objekt.string() + "\" -o \"" + ziel.string() + "\"" + flags + pgoFlags +
+                         " -L\"" GERLANG_RUNTIME_LIB "\" -lgerlang";
+    if (system(kompilieren.c_str()) != 0 || system(linken.c_str()) != 0) {
+        return 1;
+    }
+    if (!training) {
+        if (!pgoFlags.empty()) std::cout << "-> [gppc] PGO: Mit Profil aus '" << ordner.string() << "' optimiert." << std::endl;
+        return 0;
+    }
+
+    std::ofstream(hashDatei) << hash << "\n";
+    std::cout << "-> [gppc] PGO: Trainingslauf: " << trainingsBefehl << std::endl;
+    int trainingsStatus = system(trainingsBefehl.c_str());
+    if (!fs::exists(profil)) {
+        std::cerr << "-> [gppc] Fehler: Der Trainingslauf hat kein Profil geschrieben (lief das Programm '" << outputName << "'?)." << std::endl;
+        return 2;
+    }
+    if (trainingsStatus != 0) {
+        std::cerr << "-> [gppc] Warnung: Der Trainingslauf endete mit einem Fehler, das Profil ist evtl. unvollständig." << std::endl;
+    }
+    std::cout << "-> [gppc] PGO: Profil geschrieben. Jetzt optimiert kompilieren mit --pgo-use." << std::endl;
+    return 0;
+}
+
+static void meldeDiagnosen(const gppc::Ergebnis& ergebnis) {       // Gibt die Fehler aus der Bibliothek so aus, wie gppc sie immer gemeldet hat.
+    for (auto& diagnose : ergebnis.diagnosen) {
+        const char* art = diagnose.art == gppc::Diagnose::Art::Syntax ? "Parser Fehler: "
+                        : diagnose.art == gppc::Diagnose::Art::Semantik ? "Semantik Fehler: " : "Modul Fehler: ";
+        std::cerr << art << diagnose.meldung() << std::endl;
+    }
+}
+
+static void druckeBericht(const std::string& titel, const std::string& bericht) {       // Gibt einen Bericht der Bibliothek eingerückt unter einer Überschrift aus.
+    std::cout << "-> [gppc] " << titel << ":" << std::endl;
+    std::istringstream zeilen(bericht);
+    for (std::string zeile; std::getline(zeilen, zeile);) {
+        std::cout << "   " << zeile << std::endl;
+    }
+}
 
 /*
  * ============================================
@@ -21,25 +108,75 @@
  * Der Haupteinstiegspunkt des gppc Compilers (Transpilers).
  *
  * Ablauf:
- * 1. Liest den Dateinamen der .gc-Datei aus den Kommandozeilenargumenten.
+ * 1. Liest den Dateinamen der .gc-Datei und die Optionen (z.B. --zeilenweise) aus den Kommandozeilenargumenten.
  * 2. Öffnet und liest die .gc Quelldatei komplett ein.
- * 3. Startet den Lexer (lexer.cpp), um den Quelltext in eine Liste von Tokens zu zerlegen.
- * 4. Startet den Parser (parser.cpp), um aus den Tokens einen Abstract Syntax Tree (AST) zu bauen.
- * 5. Startet den Generator (generator.cpp), um aus dem AST C++-Code zu erzeugen.
- * 6. Schreibt den generierten C++-Code in eine temporäre Datei (_temp.cpp).
- * 7. Ruft den externen C++ Compiler (g++) auf, um die temporäre Datei zu kompilieren und das finale Programm zu erstellen.
- * 8. Löscht die temporäre C++-Datei.
- * 9. Gibt Erfolgs- oder Fehlermeldungen auf der Konsole aus.
+ * 3.-5. Übersetzt den Quelltext mit der Bibliothek libgppc (gppc.h): Lexer, Parser, Analyse und Generator.
+ *    Ohne weitere Optionen geht der Code dabei direkt in die Standardeingabe von g++ (ausgabe.cpp), ohne
+ *    temporäre Datei. Bei --pgo-train/--pgo-use liegt der Code in .gppc_pgo/<programm>/ (siehe kompiliereMitPgo),
+ *    bei --cpp=<datei> wird er nur in die Datei geschrieben.
+ * 6. Programme mit HOLE-Modulen übersetzt stattdessen der ModulGraph (module.cpp) Datei für Datei.
+ * 7. g++ kompiliert und linkt gegen die Laufzeitbibliothek (libgerlang.a).
+ * 8. Gibt Erfolgs- oder Fehlermeldungen auf der Konsole aus.
  */
 int main(int argc, char* argv[]) {
     // 1. Argumente prüfen
-    if (argc != 2) {
-        std::cerr << "Benutzung: ./gppc <dateiname.gc>" << std::endl;
+    std::string gcDateiname;
+    std::string zusatzFlags;
+    gppc::Optionen optionen;
+    optionen.threads = 0;       // gppc nutzt alle Kerne, wenn --jobs nichts anderes sagt.
+    std::string pgoModus;       // "", "train" oder "use"
+    std::string trainingsBefehl;
+    std::string cppDatei;       // --cpp=<datei>: nur den C++-Code schreiben
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--zeilenweise") {
+            zusatzFlags += " -DGERLANG_ZEILENWEISE"; // DRUCKE flusht wieder nach jeder Zeile
+        } else if (arg == "-g") {
+            zusatzFlags += " -g";                   // Debug-Infos; dank #line zeigen sie auf die .gc-Datei
+        } else if (arg == "--profile") {
+            optionen.profil = true;                 // Laufzeitprofil pro Funktion (gerlang_profil.txt)
+        } else if (arg == "--profile-schleifen") {
+            optionen.profil = true;                 // wie --profile, zusätzlich pro Schleife
+            optionen.profilSchleifen = true;
+        } else if (arg == "--pgo-train" && i + 1 < argc) {
+            pgoModus = "train";                     // Instrumentiert bauen und den Trainingsbefehl ausführen
+            trainingsBefehl = argv[++i];
+        } else if (arg == "--pgo-use") {
+            pgoModus = "use";                       // Mit dem Profil aus dem Training optimieren
+        } else if (arg == "--constexpr-bericht") {
+            optionen.constexprBericht = true;       // constexpr-Funktionen und gefaltete Aufrufe auflisten
+        } else if (arg == "--vektor-bericht") {
+            optionen.vektorBericht = true;          // FUER-Schleifen mit und ohne #pragma omp simd auflisten
+        } else if (arg.rfind("--cpp=", 0) == 0 && arg.size() > 6) {
+            cppDatei = arg.substr(6);               // Generierten C++-Code in eine Datei schreiben statt zu kompilieren
+        } else if (arg.rfind("--jobs=", 0) == 0) {
+            std::string jobs = arg.substr(7);       // Threads für den Generator (Standard: alle Kerne)
+            if (jobs.empty() || jobs.size() > 4 || jobs.find_first_not_of("0123456789") != std::string::npos || std::stoi(jobs) == 0) {
+                std::cerr << "Fehler: --jobs erwartet eine positive Zahl." << std::endl;
+                return 1;
+            }
+            optionen.threads = static_cast<unsigned>(std::stoi(jobs));
+        } else if (arg.rfind("--merke-grenze=", 0) == 0) {
+            std::string grenze = arg.substr(15);     // Standardgrenze der MERKE-Caches (Einträge pro Funktion und Thread)
+            if (grenze.empty() || grenze.size() > 18 || grenze.find_first_not_of("0123456789") != std::string::npos || std::stoull(grenze) == 0) {
+                std::cerr << "Fehler: --merke-grenze erwartet eine positive Zahl." << std::endl;
+                return 1;
+            }
+            zusatzFlags += " -DGERLANG_MERKE_GRENZE=" + grenze;
+        } else if (arg.rfind("--", 0) != 0 && gcDateiname.empty()) {
+            gcDateiname = arg;
+        } else {
+            gcDateiname.clear();
+            break;
+        }
+    }
+    if (gcDateiname.empty()) {
+        std::cerr << "Benutzung: ./gppc [-g] [--zeilenweise] [--merke-grenze=N] [--profile | --profile-schleifen]"
+                  << " [--pgo-train \"<befehl>\" | --pgo-use] [--cpp=<datei.cpp>] [--jobs=N]"
+                  << " [--constexpr-bericht] [--vektor-bericht] <dateiname.gc>" << std::endl;
         return 1;
     }
     
-    std::string gcDateiname = argv[1];
-    
     // 2. Datei einlesen
     std::ifstream datei(gcDateiname);
     if (!datei.is_open()) {
@@ -51,52 +188,99 @@ int main(int argc, char* argv[]) {
     std::string quelltext = buffer.str();
     datei.close();
 
-    // 3. Lexer starten
-    std::cout << "-> [gppc] Phase 1: Lexer startet..." << std::endl;
-    Lexer lexer(quelltext);
-    std::vector<Token> tokens = lexer.alleTokens();
-
-    // 4. Parser starten
-    std::cout << "-> [gppc] Phase 2: Parser startet..." << std::endl;
-    Parser parser(tokens);
-    std::unique_ptr<Program> ast;
-    try {
-        ast = parser.parse();
-    } catch (const ParseError& e) {
-        std::cerr << "Parser Fehler: " << e.what() << std::endl;
-        return 1; // Bei Syntaxfehler abbrechen
-    }
-
-    // 5. Generator starten
-    std::cout << "-> [gppc] Phase 3: Generator startet..." << std::endl;
-    Generator generator(std::move(ast));
-    std::string cppCode = generator.generate();
-    
-    // 6. Temporäre C++ Datei schreiben
-    std::string tempCppDatei = "_temp.cpp";
-    std::ofstream tempOut(tempCppDatei);
-    tempOut << cppCode;
-    tempOut.close();
-    
+    // #line-Direktiven verweisen auf den absoluten Pfad, weil g++ den Code über eine Pipe (bzw. aus .gppc_pgo/) liest.
+    optionen.quellDatei = std::filesystem::absolute(gcDateiname).lexically_normal().string();
+
     // Zieldateinamen bestimmen (z.B. "test.gc" -> "test")
     std::string outputName = gcDateiname.substr(0, gcDateiname.find_last_of("."));
+    // -fopenmp-simd: #pragma omp simd vor Schleifen ohne Abhängigkeiten wirkt, ohne die OpenMP-Laufzeit zu brauchen.
+    std::string compilerFlags = " -std=c++17 -O2 -pthread -fopenmp-simd" + zusatzFlags;
 
-    // 7. Externen Compiler (g++) aufrufen
-    std::cout << "-> [gppc] Phase 4: Kompiliere zu '" << outputName << "'..." << std::endl;
-    std::string compileBefehl = "g++ " + tempCppDatei + " -o " + outputName + " -std=c++17";
-    
-    int compileStatus = system(compileBefehl.c_str());
-    
-    // 8. Temporäre Datei löschen
-    remove(tempCppDatei.c_str());
+    // 3.-5. Übersetzen. Die Ausgabeziele öffnen sich erst beim ersten Schreiben, g++ startet also nur bei fehlerfreiem Programm.
+    gppc::Ergebnis ergebnis;
+    std::string cppCode;
+    int compileStatus = 0;
+    if (!cppDatei.empty()) {
+        std::cout << "-> [gppc] Phase 1: Übersetze nach '" << cppDatei << "'..." << std::endl;
+        DateiAusgabe ausgabe(cppDatei);
+        ergebnis = gppc::compile(quelltext, optionen, ausgabe);
+        if (ergebnis.ok() && !ausgabe.leere()) {
+            std::cerr << "Fehler: '" << cppDatei << "' konnte nicht geschrieben werden." << std::endl;
+            return 1;
+        }
+    } else if (!pgoModus.empty()) {
+        std::cout << "-> [gppc] Phase 1: Übersetze nach C++..." << std::endl;
+        ergebnis = gppc::compile(quelltext, optionen);
+    } else {
+        // Der Code geht über eine Pipe an den Compiler, ohne temporäre Datei.
+        std::cout << "-> [gppc] Phase 1: Übersetze nach C++ und kompiliere zu '" << outputName << "'..." << std::endl;
+        std::string compileBefehl = "g++ -x c++ - -o \"" + outputName + "\"" + compilerFlags +
+                                    " -I\"" GERLANG_RUNTIME_INCLUDE "\" -L\"" GERLANG_RUNTIME_LIB "\" -lgerlang";
+        std::signal(SIGPIPE, SIG_IGN);     // Bricht g++ früh ab, liefert write() EPIPE, statt gppc zu beenden.
+        CompilerAusgabe compiler(compileBefehl);
+        ergebnis = gppc::compile(quelltext, optionen, compiler);
+        if (ergebnis.ok()) compileStatus = compiler.schliesse();
+    }
+
+    // 6. Programme mit HOLE ... VON werden modulweise übersetzt und inkrementell gebaut (module.cpp).
+    if (ergebnis.mitModulen) {
+        if (optionen.profil || !pgoModus.empty() || !cppDatei.empty() || optionen.constexprBericht || optionen.vektorBericht) {
+            std::cerr << "Fehler: --profile, --pgo-*, --cpp, --constexpr-bericht und --vektor-bericht unterstützen noch keine Programme mit HOLE-Modulen." << std::endl;
+            return 1;
+        }
+        std::cout << "-> [gppc] Phase 2: Module laden, analysieren und generieren..." << std::endl;
+        GeneratorOptionen generatorOptionen;
+        generatorOptionen.quellDatei = optionen.quellDatei;
+        generatorOptionen.threads = optionen.threads;
+        ModulGraph graph(gcDateiname, nullptr, generatorOptionen);
+        try {
+            graph.lade();
+            graph.generiere();
+        } catch (const ModulFehler& e) {
+            std::cerr << "Modul Fehler: " << e.what() << std::endl;
+            return 1;
+        } catch (const ParseError& e) {
+            std::cerr << "Parser Fehler: " << e.what() << std::endl;
+            return 1;
+        } catch (const SemanticError& e) {
+            std::cerr << "Semantik Fehler: " << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << "-> [gppc] Phase 3: Kompiliere geänderte Module und linke '" << outputName << "'..." << std::endl;
+        if (graph.baue(outputName, compilerFlags) != 0) {
+            std::cerr << "-> [gppc] Fehler beim Kompilieren mit g++!" << std::endl;
+            return 1;
+        }
+        std::cout << "-> [gppc] Erfolg! Programm '" << outputName << "' wurde erstellt." << std::endl;
+        return 0;
+    }
+
+    if (!ergebnis.ok()) {
+        meldeDiagnosen(ergebnis);
+        return 1;
+    }
+    if (optionen.constexprBericht) {
+        druckeBericht("constexpr-Bericht", ergebnis.constexprBericht);
+    }
+    if (optionen.vektorBericht) {
+        druckeBericht("Vektor-Bericht", ergebnis.vektorBericht);
+    }
+    if (!cppDatei.empty()) {
+        std::cout << "-> [gppc] Erfolg! C++-Code steht in '" << cppDatei << "'." << std::endl;
+        return 0;
+    }
+    if (!pgoModus.empty()) {
+        std::cout << "-> [gppc] Phase 2: Kompiliere zu '" << outputName << "'..." << std::endl;
+        compileStatus = kompiliereMitPgo(pgoModus == "train", trainingsBefehl, ergebnis.cpp, outputName, compilerFlags);
+    }
     
-    // 9. Ergebnis melden
+    // 7./8. Ergebnis melden
     if (compileStatus == 0) {
         std::cout << "-> [gppc] Erfolg! Programm '" << outputName << "' wurde erstellt." << std::endl;
         std::cout << "-> Führe es aus mit: ./" << outputName << std::endl;
-    } else {
+    } else if (compileStatus != 2) {
         std::cerr << "-> [gppc] Fehler beim Kompilieren mit g++!" << std::endl;
     }
     
-    return compileStatus;
-}
\ No newline at end of file
+    return compileStatus == 0 ? 0 : 1;
+}
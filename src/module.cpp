@@ -0,0 +1,201 @@
+#include "module.h"
+#include "lexer.h"
+#include "parser.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Pfade zur Laufzeitbibliothek, vom Makefile gesetzt (siehe main.cpp).
+#ifndef GERLANG_RUNTIME_INCLUDE
+#define GERLANG_RUNTIME_INCLUDE "runtime"
+#endif
+#ifndef GERLANG_RUNTIME_LIB
+#define GERLANG_RUNTIME_LIB "."
+#endif
+
+namespace fs = std::filesystem;
+
+std::string quellHash(const std::string& text) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    std::ostringstream hex;
+    hex << std::hex << hash;
+    return hex.str();
+}
+
+static std::string leseDatei(const fs::path& pfad) {       // Liest eine Datei komplett ein; leer, wenn sie fehlt.
+    std::ifstream datei(pfad, std::ios::binary);
+    std::stringstream inhalt;
+    inhalt << datei.rdbuf();
+    return inhalt.str();
+}
+
+static void schreibeWennGeaendert(const fs::path& pfad, const std::string& inhalt) {     // Schreibt nur bei geändertem Inhalt, damit Zeitstempel stabil bleiben.
+    if (fs::exists(pfad) && leseDatei(pfad) == inhalt) return;
+    std::ofstream(pfad, std::ios::binary) << inhalt;
+}
+
+ModulGraph::ModulGraph(const std::string& hauptDatei, std::unique_ptr<Program> hauptAst, GeneratorOptionen optionen)     // Nimmt das bereits geparste Hauptprogramm entgegen; ohne AST liest lade() auch die Hauptdatei selbst.
+    : m_optionen(std::move(optionen)), m_hauptPfad(fs::absolute(hauptDatei).lexically_normal()), m_hauptAst(std::move(hauptAst)) {
+    m_cache = m_hauptPfad.parent_path() / ".gppc_module";
+}
+
+void ModulGraph::lade() {       // Lädt alle importierten Module rekursiv und prüft, dass es die importierten Funktionen gibt.
+    std::vector<Modul*> stapel;
+    ladeModul(m_hauptPfad, std::move(m_hauptAst), stapel);
+
+    for (Modul* modul : m_reihenfolge) {
+        for (auto& stmt : modul->ast->statements) {
+            auto id = dynamic_cast<ImportDeclaration*>(stmt.get());
+            if (id == nullptr) continue;
+            Modul* ziel = m_module.at((modul->pfad.parent_path() / id->modul).lexically_normal()).get();
+            for (auto& name : id->namen) {
+                if (!ziel->rueckgabeTypen.count(name)) {
+                    throw ModulFehler(modul->pfad.filename().string() + ", Zeile " + std::to_string(id->zeile) +
+                                      ": '" + name + "' ist keine Funktion in " + id->modul);
+                }
+                ziel->exportiert.insert(name);
+            }
+        }
+    }
+}
+
+Modul* ModulGraph::ladeModul(const fs::path& pfad, std::unique_ptr<Program> ast, std::vector<Modul*>& stapel) {     // Tiefensuche über die HOLE-Importe. `stapel` enthält die Module auf dem aktuellen Pfad und erkennt Zyklen.
+    auto vorhanden = m_module.find(pfad);
+    if (vorhanden != m_module.end()) {
+        for (Modul* m : stapel) {
+            if (m == vorhanden->second.get()) {
+                std::string zyklus;
+                for (Modul* s : stapel) zyklus += s->pfad.filename().string() + " -> ";
+                throw ModulFehler("Zyklische Abhängigkeit: " + zyklus + pfad.filename().string());
+            }
+        }
+        return vorhanden->second.get();
+    }
+
+    auto modul = std::make_unique<Modul>();
+    modul->pfad = pfad;
+    modul->schluessel = pfad.stem().string() + "_" + quellHash(pfad.string()).substr(0, 8);
+    if (ast != nullptr) {
+        modul->ast = std::move(ast);
+    } else {
+        if (!fs::exists(pfad)) {
+            throw ModulFehler("Modul '" + pfad.string() + "' wurde nicht gefunden (importiert von " +
+                              stapel.back()->pfad.filename().string() + ")");
+        }
+        if (!stapel.empty()) std::cout << "-> [gppc] Lade Modul '" << pfad.filename().string() << "'..." << std::endl;
+        Lexer lexer(leseDatei(pfad));
+        Parser parser(lexer.alleTokens());
+        modul->ast = parser.parse();
+        if (!parser.fehler().empty()) {
+            std::string meldung;
+            for (auto& fehler : parser.fehler()) meldung += (meldung.empty() ? "" : "\n") + pfad.filename().string() + ", " + fehler;
+            throw ParseError(meldung);
+        }
+    }
+    for (auto& stmt : modul->ast->statements) {
+        if (auto fd = dynamic_cast<FunctionDeclaration*>(stmt.get())) {
+            if (fd->name == "haupt" && !stapel.empty()) {
+                throw ModulFehler("Das Modul " + pfad.filename().string() + " darf keine Funktion 'haupt' enthalten");
+            }
+            modul->rueckgabeTypen[fd->name] = fd->returnTyp;
+        }
+    }
+
+    Modul* zeiger = modul.get();
+    m_module[pfad] = std::move(modul);
+    stapel.push_back(zeiger);
+    for (auto& stmt : zeiger->ast->statements) {
+        if (auto id = dynamic_cast<ImportDeclaration*>(stmt.get())) {
+            fs::path ziel = (pfad.parent_path() / id->modul).lexically_normal();
+            zeiger->abhaengigkeiten.push_back(ladeModul(ziel, nullptr, stapel));
+        }
+    }
+    stapel.pop_back();
+    m_reihenfolge.push_back(zeiger);
+    return zeiger;
+}
+
+void ModulGraph::generiere() {      // Analysiert und generiert die Module in Abhängigkeitsreihenfolge, damit Rückgabetypen und Reinheit der Importe bekannt sind.
+    for (Modul* modul : m_reihenfolge) {
+        for (auto& stmt : modul->ast->statements) {
+            auto id = dynamic_cast<ImportDeclaration*>(stmt.get());
+            if (id == nullptr) continue;
+            Modul* ziel = m_module.at((modul->pfad.parent_path() / id->modul).lexically_normal()).get();
+            id->header = (m_cache / (ziel->schluessel + ".h")).string();
+            id->rueckgabeTypen.clear();
+            for (auto& name : id->namen) {
+                id->rueckgabeTypen.push_back(ziel->rueckgabeTypen[name]);
+                auto grund = ziel->unreineFunktionen.find(name);
+                if (grund != ziel->unreineFunktionen.end()) id->unreineFunktionen[name] = grund->second;
+            }
+        }
+
+        Analyzer analyzer;
+        AnalyseErgebnis analyse = analyzer.analysiere(modul->ast.get());
+        modul->unreineFunktionen = analyse.unreineFunktionen;
+
+        GeneratorOptionen optionen = m_optionen;
+        optionen.quellDatei = modul->pfad.string();
+        optionen.konstant = m_optionen.konstant && modul->pfad == m_hauptPfad;     // constexpr ist implizit inline; importierte Module brauchen echte Funktionen für ihre Prototypen.
+        optionen.exportiert = modul->exportiert;
+        Generator generator(std::move(modul->ast), std::move(analyse), optionen);
+        modul->cppCode = generator.generate();
+        modul->header = generator.schnittstelle();
+    }
+}
+
+int ModulGraph::baue(const std::string& ausgabe, const std::string& compilerFlags) {       // Kompiliert geänderte Module zu Objektdateien und linkt alle zum Programm.
+    fs::create_directories(m_cache);
+    std::string objekte;
+
+    // Jeder generierte Code bindet die Header der Laufzeitbibliothek ein; ändern sie sich, sind alle Objekte veraltet.
+    std::vector<fs::path> laufzeitHeader;
+    std::error_code fehler;
+    for (auto& eintrag : fs::directory_iterator(GERLANG_RUNTIME_INCLUDE, fehler)) {
+        std::string datei = eintrag.path().filename().string();
+        if (datei.rfind("gerlang", 0) == 0 && eintrag.path().extension() == ".h") laufzeitHeader.push_back(eintrag.path());
+    }
+    std::sort(laufzeitHeader.begin(), laufzeitHeader.end());
+    std::string laufzeit;
+    for (auto& pfad : laufzeitHeader) laufzeit += leseDatei(pfad);
+
+    for (Modul* modul : m_reihenfolge) {
+        fs::path basis = m_cache / modul->schluessel;
+        schreibeWennGeaendert(basis.string() + ".h", modul->header);
+
+        // Ein Modul hängt von seinem Code und den Headern seiner Importe ab (nicht von deren Funktionskörpern).
+        std::string eingaben = modul->cppCode + compilerFlags + laufzeit;
+        for (Modul* abh : modul->abhaengigkeiten) eingaben += abh->header;
+        std::string hash = quellHash(eingaben);
+
+        fs::path objekt = basis.string() + ".o";
+        fs::path hashDatei = basis.string() + ".hash";
+        std::string name = modul->pfad.filename().string();
+        if (fs::exists(objekt) && leseDatei(hashDatei) == hash) {
+            std::cout << "-> [gppc] " << name << ": unverändert" << std::endl;
+        } else {
+            std::cout << "-> [gppc] " << name << ": kompiliere" << std::endl;
+            schreibeWennGeaendert(basis.string() + ".cpp", modul->cppCode);
+            std::string befehl = "g++ -c \"" + basis.string() + ".cpp\" -o \"" + objekt.string() + "\"" + compilerFlags +
+                                 " -I\"" GERLANG_RUNTIME_INCLUDE "\"";
+            if (system(befehl.c_str()) != 0) {
+                fs::remove(hashDatei);
+                return 1;
+            }
+            std::ofstream(hashDatei, std::ios::binary) << hash;
+        }
+        objekte += " \"" + objekt.string() + "\"";
+    }
+
+    std::cout << "-> [gppc] Linke " << m_reihenfolge.size() << " Module..." << std::endl;
+    std::string linken = "g++" + objekte + " -o \"" + ausgabe + "\"" + compilerFlags +
+                         " -L\"" GERLANG_RUNTIME_LIB "\" -lgerlang";
+    return system(linken.c_str()) == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ast.h"
+#include "analyzer.h"
+#include "generator.h"
+
+class ModulFehler : public std::runtime_error {
+public:
+    ModulFehler(const std::string& message) : std::runtime_error(message) {}
+};
+
+// FNV-1a über einen Text, hexadezimal. Erkennt geänderten generierten Code (Module, PGO-Profile).
+std::string quellHash(const std::string& text);
+
+// Eine .gc-Datei im Abhängigkeitsgraphen. Das Hauptprogramm ist auch ein Modul.
+struct Modul {
+    std::filesystem::path pfad;                 // Absolut.
+    std::unique_ptr<Program> ast;
+    std::vector<Modul*> abhaengigkeiten;
+    std::string schluessel;                     // Dateiname im Cache, z.B. "mathe_1a2b3c4d".
+    std::map<std::string, std::string> rueckgabeTypen;      // Funktionen des Moduls -> GerLang-Rückgabetyp.
+    std::map<std::string, std::string> unreineFunktionen;   // Aus der Analyse, für MERKE in importierenden Modulen.
+    std::set<std::string> exportiert;           // Funktionen, die andere Module mit HOLE importieren.
+    std::string header;                         // Generierter Header (Prototypen der exportierten Funktionen).
+    std::string cppCode;
+};
+
+// Lädt ein Programm mit allen HOLE-Importen, übersetzt jedes Modul in ein eigenes
+// Header/Objekt-Paar im Cache (.gppc_module/ neben dem Hauptprogramm) und linkt sie.
+// Ein Modul wird nur neu kompiliert, wenn sich sein generierter Code, der Header
+// eines importierten Moduls oder ein Header der Laufzeitbibliothek geändert hat.
+// Nur die importierten Funktionen eines Moduls stehen in seinem Header; alle
+// anderen sind static, damit gleichnamige Hilfsfunktionen nicht kollidieren.
+class ModulGraph {
+public:
+    ModulGraph(const std::string& hauptDatei, std::unique_ptr<Program> hauptAst, GeneratorOptionen optionen);
+
+    void lade();
+    void generiere();
+    int baue(const std::string& ausgabe, const std::string& compilerFlags);
+
+private:
+    GeneratorOptionen m_optionen;
+    std::filesystem::path m_cache;
+    std::map<std::filesystem::path, std::unique_ptr<Modul>> m_module;
+    std::vector<Modul*> m_reihenfolge;          // Abhängigkeiten vor den Modulen, die sie importieren.
+    std::filesystem::path m_hauptPfad;
+    std::unique_ptr<Program> m_hauptAst;
+
+    Modul* ladeModul(const std::filesystem::path& pfad, std::unique_ptr<Program> ast, std::vector<Modul*>& stapel);
+};
@@ -1,23 +1,45 @@
 #include "parser.h"
+#include "analyzer.h"
+#include <charconv>
 #include <stdexcept>
 
-Parser::Parser(const std::vector<Token>& tokens) : m_tokens(tokens) {}
+static int ganzLiteral(const Token& zahl) {       // Wert eines GANZ-Literals. Was nicht in int passt, ist ein Syntaxfehler (std::stoi würde werfen).
+    std::string_view text = zahl.text();
+    int wert = 0;
+    auto [ende, fehler] = std::from_chars(text.data(), text.data() + text.size(), wert);
+    if (fehler != std::errc() || ende != text.data() + text.size()) {
+        throw ParseError("Zeile " + std::to_string(zahl.zeile()) + ": Die Zahl " + zahl.wert() + " passt nicht in GANZ");
+    }
+    return wert;
+}
+
+static float kommaLiteral(const Token& zahl) {       // Wert eines KOMMA-Literals. Was außerhalb von float liegt, ist ein Syntaxfehler.
+    std::string_view text = zahl.text();
+    float wert = 0;
+    auto [ende, fehler] = std::from_chars(text.data(), text.data() + text.size(), wert);
+    if (fehler != std::errc() || ende != text.data() + text.size()) {
+        throw ParseError("Zeile " + std::to_string(zahl.zeile()) + ": Die Zahl " + zahl.wert() + " passt nicht in KOMMA");
+    }
+    return wert;
+}
+
+Parser::Parser(TokenListe tokens) : m_tokens(std::move(tokens)) {}
 
-Token& Parser::peek() { return m_tokens[m_current]; }
-Token& Parser::previous() { return m_tokens[m_current - 1]; }
-bool Parser::isAtEnd() { return peek().typ == TokenType::DATEIENDE; }
+Token Parser::peek() { return m_tokens[m_current]; }
+Token Parser::previous() { return m_tokens[m_current - 1]; }
+bool Parser::isAtEnd() { return m_tokens.typ(m_current) == TokenType::DATEIENDE; }
 
-Token& Parser::advance() {
+Token Parser::advance() {
     if (!isAtEnd()) m_current++;
     return previous();
 }
 
 bool Parser::check(TokenType typ) {
     if (isAtEnd()) return false;
-    return peek().typ == typ;
+    return m_tokens.typ(m_current) == typ;
 }
 
-bool Parser::match(std::vector<TokenType> typen) {
+bool Parser::match(std::initializer_list<TokenType> typen) {
     for (TokenType t : typen) {
         if (check(t)) {
             advance();
@@ -27,11 +49,18 @@ bool Parser::match(std::vector<TokenType> typen) {
     return false;
 }
 
-Token& Parser::consume(TokenType typ, const std::string& errorMsg) {
+Token Parser::consume(TokenType typ, const std::string& errorMsg) {
     if (check(typ)) return advance();
-    throw ParseError("Zeile " + std::to_string(peek().zeile) + ": " + errorMsg + 
+    throw ParseError("Zeile " + std::to_string(peek().zeile()) + ": " + errorMsg + 
                      ". Erwartet: " + tokenTypeToString(typ) + 
-                     ", aber gefunden: " + tokenTypeToString(peek().typ));
+                     ", aber gefunden: " + tokenTypeToString(peek().typ()));
+}
+
+void Parser::setzePosition(ASTNode* knoten, const Token& token) {     // Merkt sich Zeile und Spalte des ersten Tokens eines Knotens (für #line im generierten Code und Fehlermeldungen).
+    if (knoten == nullptr) return;
+    auto [zeile, spalte] = token.position();
+    knoten->zeile = zeile;
+    knoten->spalte = spalte;
 }
 
 std::unique_ptr<Program> Parser::parse() {  // Startet den Parsing-Vorgang für das gesamte Programm und gibt den fertigen AST zurück.
@@ -42,33 +71,137 @@ std::unique_ptr<Program> Parser::parse() {  // Startet den Parsing-Vorgang für
     return program;
 }
 
-std::unique_ptr<Statement> Parser::declaration() {      // Parst eine Deklaration auf oberster Ebene (Funktion oder globale Variable - letzteres noch nicht implementiert). Entscheidet anhand der Tokens, was folgt.
+std::unique_ptr<Statement> Parser::declaration() {      // Parst eine Deklaration auf oberster Ebene (Funktion, globale Variable oder HOLE-Import). Entscheidet anhand der Tokens, was folgt.
     try {
-        if (check(TokenType::GANZ) || check(TokenType::WORT) || check(TokenType::JAIN) || check(TokenType::KISTE) || check(TokenType::KOMMA)) {
-            if (m_current + 2 < m_tokens.size() && 
-                m_tokens[m_current + 1].typ == TokenType::IDENTIFIER && 
-                m_tokens[m_current + 2].typ == TokenType::LPAREN) 
-            {
-                return functionDeclaration();
-            } else {
-                return variableDeclaration();
-            }
+        Token start = peek();
+        if (match({TokenType::MERKE})) {
+            return merkeDeclaration();
+        }
+        if (match({TokenType::HOLE})) {
+            auto decl = importDeclaration();
+            setzePosition(decl.get(), start);
+            return decl;
+        }
+        if (match({TokenType::KOMPAKT})) {
+            consume(TokenType::STRUKTUR, "Erwarte STRUKTUR nach KOMPAKT");
+            auto decl = strukturDeclaration(true);
+            setzePosition(decl.get(), start);
+            return decl;
+        }
+        if (match({TokenType::STRUKTUR})) {
+            auto decl = strukturDeclaration(false);
+            setzePosition(decl.get(), start);
+            return decl;
+        }
+        if (istTyp()) {
+            auto decl = istFunktionsKopf() ? functionDeclaration() : variableDeclaration();
+            setzePosition(decl.get(), start);
+            return decl;
         }
         
-        throw ParseError("Zeile " + std::to_string(peek().zeile) + 
+        throw ParseError("Zeile " + std::to_string(peek().zeile()) + 
                          ": Erwarte eine Deklaration (z.B. GANZ ...)");
 
     } catch (ParseError& e) {
-        std::cerr << "Parser Fehler: " << e.what() << std::endl;
+        m_fehler.push_back(e.what());       // Merken und nach dem fehlerhaften Token weiterlesen, um weitere Fehler zu finden.
         advance(); 
         return nullptr; 
     }
 }
 
+bool Parser::istFunktionsKopf() {       // Schaut voraus, ob ab dem aktuellen Typ-Token ein Funktionskopf `Typ name(` folgt.
+    size_t nachTyp = m_current + 1;
+    if (m_tokens.typ(m_current) == TokenType::KARTE) {
+        int tiefe = 0;      // KARTE<K, V> überspringen, auch verschachtelt.
+        for (; nachTyp < m_tokens.size() && m_tokens.typ(nachTyp) != TokenType::DATEIENDE; ++nachTyp) {
+            if (m_tokens.typ(nachTyp) == TokenType::LT) ++tiefe;
+            if (m_tokens.typ(nachTyp) == TokenType::GT && --tiefe == 0) break;
+        }
+        ++nachTyp;
+    }
+    if (nachTyp + 1 < m_tokens.size() &&
+        m_tokens.typ(nachTyp) == TokenType::LBRACKET &&
+        m_tokens.typ(nachTyp + 1) == TokenType::RBRACKET) {
+        nachTyp += 2;   // Array-Rückgabetyp, z.B. GANZ[] f(...)
+    }
+    return nachTyp + 1 < m_tokens.size() &&
+           m_tokens.typ(nachTyp) == TokenType::IDENTIFIER &&
+           m_tokens.typ(nachTyp + 1) == TokenType::LPAREN;
+}
+
+std::unique_ptr<Statement> Parser::merkeDeclaration() {     // Parst `MERKE [(grenze)] Typ name(...) {...}`. Die Reinheit prüft erst die Analyse.
+    int grenze = 0;
+    if (match({TokenType::LPAREN})) {
+        Token zahl = consume(TokenType::INT_LITERAL, "Erwarte die Cache-Grenze als Zahl in MERKE(...)");
+        grenze = ganzLiteral(zahl);
+        if (grenze <= 0) {
+            throw ParseError("Zeile " + std::to_string(zahl.zeile()) + ": Die Cache-Grenze in MERKE(...) muss größer als 0 sein");
+        }
+        consume(TokenType::RPAREN, "Erwarte ')' nach der Cache-Grenze");
+    }
+    if (!istFunktionsKopf()) {
+        throw ParseError("Zeile " + std::to_string(peek().zeile()) + ": MERKE ist nur vor einer Funktionsdefinition erlaubt");
+    }
+    Token start = peek();
+    auto stmt = functionDeclaration();
+    setzePosition(stmt.get(), start);
+    auto func = static_cast<FunctionDeclaration*>(stmt.get());
+    func->merke = true;
+    func->merkeGrenze = grenze;
+    return stmt;
+}
+
+std::unique_ptr<Statement> Parser::strukturDeclaration(bool kompakt) {     // Parst `[KOMPAKT] STRUKTUR Name { Typ feld; ... }`. Danach ist Name ein Typ und Name(...) erzeugt einen Wert.
+    auto decl = std::make_unique<StrukturDeclaration>();
+    decl->kompakt = kompakt;
+    Token name = consume(TokenType::IDENTIFIER, "Erwarte den Namen der STRUKTUR");
+    decl->name = name.wert();
+    if (m_strukturen.count(decl->name)) {
+        throw ParseError("Zeile " + std::to_string(name.zeile()) + ": STRUKTUR '" + decl->name + "' ist bereits deklariert");
+    }
+    consume(TokenType::LBRACE, "Erwarte '{' nach dem Namen der STRUKTUR");
+    while (!check(TokenType::RBRACE) && !isAtEnd()) {
+        Token start = peek();
+        std::string typ = parseType();
+        if (typ.rfind("AUFGABE", 0) == 0) {
+            throw ParseError("Zeile " + std::to_string(start.zeile()) + ": AUFGABE ist als Feldtyp nicht erlaubt");
+        }
+        Token feld = consume(TokenType::IDENTIFIER, "Erwarte Feldnamen");
+        for (auto& vorhanden : decl->felder) {
+            if (vorhanden.second == feld.text()) {
+                throw ParseError("Zeile " + std::to_string(feld.zeile()) + ": Feld '" + feld.wert() + "' ist in STRUKTUR '" +
+                                 decl->name + "' doppelt");
+            }
+        }
+        decl->felder.push_back({typ, feld.wert()});
+        consume(TokenType::SEMICOLON, "Erwarte ';' nach Feld");
+    }
+    consume(TokenType::RBRACE, "Erwarte '}' am Ende der STRUKTUR");
+    if (decl->felder.empty()) {
+        throw ParseError("Zeile " + std::to_string(name.zeile()) + ": STRUKTUR '" + decl->name + "' braucht mindestens ein Feld");
+    }
+    m_strukturen.insert(decl->name);
+    return decl;
+}
+
+std::unique_ptr<Statement> Parser::importDeclaration() {       // Parst `HOLE f, g VON "mathe.gc";`. Das Modul lädt erst das Modulsystem.
+    auto decl = std::make_unique<ImportDeclaration>();
+    do {
+        decl->namen.push_back(consume(TokenType::IDENTIFIER, "Erwarte Funktionsnamen nach HOLE").wert());
+    } while (match({TokenType::COMMA}));
+    consume(TokenType::VON, "Erwarte VON nach den Funktionsnamen");
+    decl->modul = consume(TokenType::STRING_LITERAL, "Erwarte den Dateinamen des Moduls als Text").wert();
+    consume(TokenType::SEMICOLON, "Erwarte ';' nach HOLE-Anweisung");
+    return decl;
+}
+
 std::unique_ptr<Statement> Parser::statement() {    // Parst eine einzelne Anweisung innerhalb eines Blocks (z.B. DRUCKE, WENN, Zuweisung, Variablendeklaration).
-    if (match({TokenType::DRUCKE})) {
+    if (match({TokenType::DRUCKE, TokenType::DATEI_SCHREIBE})) {
         return printStatement();
     }
+    if (match({TokenType::LEERE})) {
+        return flushStatement();
+    }
     if (match({TokenType::ZURUECK})) {
         return returnStatement();
     }
@@ -79,36 +212,51 @@ std::unique_ptr<Statement> Parser::statement() {    // Parst eine einzelne Anwei
         return whileStatement();
     }
     if (match({TokenType::FUER})) {
+        if (match({TokenType::JEDES})) {
+            return fuerJedesStatement();
+        }
         return forStatement();
     }
+    if (match({TokenType::PARALLEL})) {
+        consume(TokenType::FUER, "Erwarte FUER nach PARALLEL");
+        return forStatement(true);
+    }
+    if (match({TokenType::HINZUFUEGEN, TokenType::SORTIERE})) {
+        return intrinsicStatement();
+    }
     
-    if (check(TokenType::GANZ) || check(TokenType::WORT) || check(TokenType::JAIN) || check(TokenType::KISTE) || check(TokenType::KOMMA)) {
+    if (istTyp()) {
         return variableDeclaration();
     }
 
-    if (check(TokenType::IDENTIFIER) && m_tokens[m_current + 1].typ == TokenType::LBRACKET) {
+    if (check(TokenType::IDENTIFIER) && m_tokens.typ(m_current + 1) == TokenType::LBRACKET) {
         return arrayAssignmentStatement(); 
     }
+
+    if (check(TokenType::IDENTIFIER) && m_tokens.typ(m_current + 1) == TokenType::DOT) {
+        return feldZuweisungStatement(nullptr);
+    }
     
-    if (check(TokenType::IDENTIFIER) && m_tokens[m_current + 1].typ == TokenType::ASSIGN) {
+    if (check(TokenType::IDENTIFIER) && m_tokens.typ(m_current + 1) == TokenType::ASSIGN) {
         return assignmentStatement();
     }
     
-    throw ParseError("Zeile " + std::to_string(peek().zeile) + ": Unerwartetes Token: " + peek().wert);
+    throw ParseError("Zeile " + std::to_string(peek().zeile()) + ": Unerwartetes Token: " + peek().wert());
 }
 
 std::unique_ptr<Statement> Parser::functionDeclaration() {  // Parst eine komplette Funktionsdefinition (Typ, Name, Parameter, Körper).
     auto func = std::make_unique<FunctionDeclaration>();
+    setzePosition(func.get(), peek());
     
     func->returnTyp = parseType();
-    func->name = consume(TokenType::IDENTIFIER, "Erwarte Funktionsnamen").wert;
+    func->name = consume(TokenType::IDENTIFIER, "Erwarte Funktionsnamen").wert();
     consume(TokenType::LPAREN, "Erwarte '(' nach Funktionsnamen");
 
     if (!check(TokenType::RPAREN)) {
         do {
             std::string paramTypName = parseType();
             Token name = consume(TokenType::IDENTIFIER, "Erwarte Parameternamen");
-            func->parameter.push_back({paramTypName, name.wert});
+            func->parameter.push_back({paramTypName, name.wert()});
         } while (match({TokenType::COMMA}));
     }
     
@@ -122,7 +270,7 @@ std::unique_ptr<Statement> Parser::functionDeclaration() {  // Parst eine komple
 std::unique_ptr<Statement> Parser::variableDeclaration() {  // Parst eine Variablendeklaration (Typ, Name, Initialisierungswert).
     auto decl = std::make_unique<VariableDeclaration>();
     decl->typName = parseType();
-    decl->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen").wert;
+    decl->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen").wert();
     consume(TokenType::ASSIGN, "Erwarte '=' nach Variablennamen");
     decl->initializer = expression();
     consume(TokenType::SEMICOLON, "Erwarte ';' nach Variablendeklaration");
@@ -131,7 +279,7 @@ std::unique_ptr<Statement> Parser::variableDeclaration() {  // Parst eine Variab
 
 std::unique_ptr<Statement> Parser::assignmentStatement() {  // Parst eine einfache Zuweisung an eine Variable (z.B. name = wert;).
     auto stmt = std::make_unique<AssignmentStatement>();
-    stmt->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen für Zuweisung").wert;
+    stmt->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen für Zuweisung").wert();
     consume(TokenType::ASSIGN, "Erwarte '=' bei Zuweisung");
     stmt->wert = expression();
     consume(TokenType::SEMICOLON, "Erwarte ';' nach Zuweisung");
@@ -140,19 +288,36 @@ std::unique_ptr<Statement> Parser::assignmentStatement() {  // Parst eine einfac
 
 std::unique_ptr<BlockStatement> Parser::blockStatement() {  // Parst einen Codeblock, der von '{' und '}' umschlossen ist und mehrere Statements enthalten kann.
     auto block = std::make_unique<BlockStatement>();
+    setzePosition(block.get(), previous());
     while (!check(TokenType::RBRACE) && !isAtEnd()) {
+        Token start = peek();
         block->statements.push_back(statement());
+        setzePosition(block->statements.back().get(), start);
     }
     consume(TokenType::RBRACE, "Erwarte '}' am Ende des Blocks");
     return block;
 }
 
-std::unique_ptr<Statement> Parser::printStatement() {   // Parst eine DRUCKE(...) Anweisung.
+std::unique_ptr<Statement> Parser::printStatement() {   // Parst eine DRUCKE(...) oder DATEI_SCHREIBE(pfad, ...) Anweisung.
     auto stmt = std::make_unique<PrintStatement>();
-    consume(TokenType::LPAREN, "Erwarte '(' nach DRUCKE");
+    Token befehl = previous();
+    std::string name = befehl.wert();
+    consume(TokenType::LPAREN, "Erwarte '(' nach " + name);
+    if (befehl.typ() == TokenType::DATEI_SCHREIBE) {
+        stmt->datei = expression();
+        consume(TokenType::COMMA, "Erwarte ',' nach dem Dateinamen in DATEI_SCHREIBE");
+    }
     stmt->expression = expression();
-    consume(TokenType::RPAREN, "Erwarte ')' nach DRUCKE-Ausdruck");
-    consume(TokenType::SEMICOLON, "Erwarte ';' nach DRUCKE-Anweisung");
+    consume(TokenType::RPAREN, "Erwarte ')' nach " + name + "-Ausdruck");
+    consume(TokenType::SEMICOLON, "Erwarte ';' nach " + name + "-Anweisung");
+    return stmt;
+}
+
+std::unique_ptr<Statement> Parser::flushStatement() {   // Parst eine LEERE(); Anweisung.
+    auto stmt = std::make_unique<FlushStatement>();
+    consume(TokenType::LPAREN, "Erwarte '(' nach LEERE");
+    consume(TokenType::RPAREN, "Erwarte ')' nach LEERE");
+    consume(TokenType::SEMICOLON, "Erwarte ';' nach LEERE-Anweisung");
     return stmt;
 }
 
@@ -173,7 +338,9 @@ std::unique_ptr<Statement> Parser::ifStatement() {      // Parst eine WENN (...)
     
     if (match({TokenType::SONST})) {
         if (match({TokenType::WENN})) {
+            Token start = previous();
             stmt->elseBranch = ifStatement();
+            setzePosition(stmt->elseBranch.get(), start);
         } else {
             consume(TokenType::LBRACE, "Erwarte '{' nach SONST");
             stmt->elseBranch = blockStatement();
@@ -184,6 +351,7 @@ std::unique_ptr<Statement> Parser::ifStatement() {      // Parst eine WENN (...)
 
 std::unique_ptr<Statement> Parser::whileStatement() {   // Parst eine SOLANGE (...) { ... } Schleife.
     auto stmt = std::make_unique<WhileStatement>();
+    setzePosition(stmt.get(), previous());
     consume(TokenType::LPAREN, "Erwarte '(' nach SOLANGE");
     stmt->condition = expression();
     consume(TokenType::RPAREN, "Erwarte ')' nach SOLANGE-Bedingung");
@@ -192,16 +360,22 @@ std::unique_ptr<Statement> Parser::whileStatement() {   // Parst eine SOLANGE (.
     return stmt;
 }
 
-std::unique_ptr<Statement> Parser::forStatement() {     // Parst eine FUER (...; ...; ...) { ... } Schleife.
+std::unique_ptr<Statement> Parser::forStatement(bool parallel) {     // Parst eine FUER (...; ...; ...) { ... } Schleife. Bei PARALLEL FUER sind nur gezählte Schleifen erlaubt, optional mit SUMME(variable).
     auto stmt = std::make_unique<ForStatement>();
+    setzePosition(stmt.get(), previous());
+    stmt->parallel = parallel;
     consume(TokenType::LPAREN, "Erwarte '(' nach FUER");
     
     if (match({TokenType::SEMICOLON})) {
         stmt->initializer = nullptr;
     } else if (check(TokenType::GANZ) || check(TokenType::WORT) || check(TokenType::JAIN) || check(TokenType::KISTE)) {
+        Token start = peek();
         stmt->initializer = variableDeclaration();
+        setzePosition(stmt->initializer.get(), start);
     } else {
+        Token start = peek();
         stmt->initializer = assignmentStatement();
+        setzePosition(stmt->initializer.get(), start);
     }
 
     if (!check(TokenType::SEMICOLON)) {
@@ -211,26 +385,59 @@ std::unique_ptr<Statement> Parser::forStatement() {     // Parst eine FUER (...;
     
     if (!check(TokenType::RPAREN)) {
         auto assign = std::make_unique<AssignmentStatement>();
-        assign->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen für Inkrement").wert;
+        setzePosition(assign.get(), peek());
+        assign->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen für Inkrement").wert();
         consume(TokenType::ASSIGN, "Erwarte '=' bei Inkrement-Zuweisung");
         assign->wert = expression();
         stmt->increment = std::move(assign);
     }
     consume(TokenType::RPAREN, "Erwarte ')' nach FUER-Klauseln");
+
+    if (parallel) {
+        Zaehlschleife schleife;
+        if (dynamic_cast<VariableDeclaration*>(stmt->initializer.get()) == nullptr || !erkenneZaehlschleife(stmt.get(), schleife)) {
+            throw ParseError("Zeile " + std::to_string(stmt->zeile) +
+                             ": PARALLEL FUER erwartet eine gezählte Schleife der Form FUER (GANZ i = a; i < b; i = i + 1)");
+        }
+        if (match({TokenType::SUMME})) {
+            consume(TokenType::LPAREN, "Erwarte '(' nach SUMME");
+            stmt->reduktion = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen in SUMME(...)").wert();
+            consume(TokenType::RPAREN, "Erwarte ')' nach SUMME-Variable");
+        }
+    }
     
     consume(TokenType::LBRACE, "Erwarte '{' nach FUER");
     stmt->body = blockStatement();
     return stmt;
 }
 
-std::unique_ptr<Statement> Parser::arrayAssignmentStatement() {     // Parst eine Zuweisung an ein Array-Element (z.B. name[index] = wert;).
+std::unique_ptr<Statement> Parser::fuerJedesStatement() {      // Parst FUER JEDES (Typ name IN ausdruck) { ... }; FUER und JEDES sind schon gelesen.
+    auto stmt = std::make_unique<FuerJedesStatement>();
+    setzePosition(stmt.get(), previous());
+    consume(TokenType::LPAREN, "Erwarte '(' nach FUER JEDES");
+    stmt->typName = parseType();
+    stmt->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen in FUER JEDES").wert();
+    consume(TokenType::IN, "Erwarte IN nach der Variable von FUER JEDES");
+    stmt->liste = expression();
+    consume(TokenType::RPAREN, "Erwarte ')' nach FUER JEDES-Klausel");
+    consume(TokenType::LBRACE, "Erwarte '{' nach FUER JEDES");
+    stmt->body = blockStatement();
+    return stmt;
+}
+
+std::unique_ptr<Statement> Parser::arrayAssignmentStatement() {     // Parst eine Zuweisung an ein Array-Element (z.B. name[index] = wert;) oder an ein Feld davon (name[index].feld = wert;).
     auto stmt = std::make_unique<ArrayAssignmentStatement>();
     
-    stmt->name = consume(TokenType::IDENTIFIER, "Erwarte Array-Namen").wert;
+    stmt->name = consume(TokenType::IDENTIFIER, "Erwarte Array-Namen").wert();
     
     consume(TokenType::LBRACKET, "Erwarte '[' nach Array-Namen");
     stmt->index = expression();
     consume(TokenType::RBRACKET, "Erwarte ']' nach Array-Index");
+    if (check(TokenType::DOT)) {
+        auto feld = feldZuweisungStatement(std::move(stmt->index));
+        static_cast<FeldZuweisungStatement*>(feld.get())->name = stmt->name;
+        return feld;
+    }
     
     consume(TokenType::ASSIGN, "Erwarte '=' bei Array-Zuweisung");
     stmt->wert = expression();
@@ -239,6 +446,47 @@ std::unique_ptr<Statement> Parser::arrayAssignmentStatement() {     // Parst ein
     return stmt;
 }
 
+std::unique_ptr<Statement> Parser::feldZuweisungStatement(std::unique_ptr<Expression> index) {     // Parst `name.feld = wert;`, bzw. nach arrayAssignmentStatement den Rest von `name[index].feld = wert;`.
+    auto stmt = std::make_unique<FeldZuweisungStatement>();
+    if (index == nullptr) {
+        stmt->name = consume(TokenType::IDENTIFIER, "Erwarte Variablennamen").wert();
+    }
+    stmt->index = std::move(index);
+    consume(TokenType::DOT, "Erwarte '.' vor dem Feldnamen");
+    stmt->feld = consume(TokenType::IDENTIFIER, "Erwarte Feldnamen nach '.'").wert();
+    consume(TokenType::ASSIGN, "Erwarte '=' bei Feld-Zuweisung");
+    stmt->wert = expression();
+    consume(TokenType::SEMICOLON, "Erwarte ';' nach Feld-Zuweisung");
+    return stmt;
+}
+
+std::unique_ptr<Statement> Parser::intrinsicStatement() {     // Parst eine eingebaute Array-Funktion als Anweisung (HINZUFUEGEN(a, x); oder SORTIERE(a);).
+    auto stmt = std::make_unique<IntrinsicStatement>();
+    stmt->aufruf = intrinsic();
+    consume(TokenType::SEMICOLON, "Erwarte ';' nach " + stmt->aufruf->name);
+    return stmt;
+}
+
+std::unique_ptr<IntrinsicExpression> Parser::intrinsic() {      // Parst die Argumente einer eingebauten Array-Funktion. Das Schlüsselwort wurde bereits gelesen.
+    auto aufruf = std::make_unique<IntrinsicExpression>();
+    setzePosition(aufruf.get(), previous());
+    aufruf->name = previous().wert();
+    consume(TokenType::LPAREN, "Erwarte '(' nach " + aufruf->name);
+    if (!check(TokenType::RPAREN)) {
+        do {
+            aufruf->argumente.push_back(expression());
+        } while (match({TokenType::COMMA}));
+    }
+    consume(TokenType::RPAREN, "Erwarte ')' nach " + aufruf->name + "-Argumenten");
+
+    size_t erwartet = (aufruf->name == "HINZUFUEGEN" || aufruf->name == "ENTHAELT") ? 2 : 1;
+    if (aufruf->argumente.size() != erwartet) {
+        throw ParseError("Zeile " + std::to_string(previous().zeile()) + ": " + aufruf->name + " erwartet " +
+                         std::to_string(erwartet) + " Argument(e)");
+    }
+    return aufruf;
+}
+
 std::unique_ptr<Expression> Parser::expression() { return logicalOr(); }    // Einstiegspunkt für das Parsen von Ausdrücken. Ruft die niedrigste Prioritätsstufe auf (logisches ODER).
 
 std::unique_ptr<Expression> Parser::logicalOr() {       // Parst logische ODER (||) Ausdrücke.
@@ -246,7 +494,8 @@ std::unique_ptr<Expression> Parser::logicalOr() {       // Parst logische ODER (
     while (match({TokenType::ODER})) {
         Token op = previous();
         std::unique_ptr<Expression> rechts = logicalAnd();
-        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert, std::move(rechts));
+        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert(), std::move(rechts));
+        setzePosition(expr.get(), op);
     }
     return expr;
 }
@@ -256,7 +505,8 @@ std::unique_ptr<Expression> Parser::logicalAnd() {      // Parst logische UND (&
     while (match({TokenType::UND})) {
         Token op = previous();
         std::unique_ptr<Expression> rechts = equality();
-        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert, std::move(rechts));
+        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert(), std::move(rechts));
+        setzePosition(expr.get(), op);
     }
     return expr;
 }
@@ -266,7 +516,8 @@ std::unique_ptr<Expression> Parser::equality() {        // Parst Gleichheits- un
     while (match({TokenType::EQ, TokenType::NEQ})) {
         Token op = previous();
         std::unique_ptr<Expression> rechts = comparison();
-        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert, std::move(rechts));
+        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert(), std::move(rechts));
+        setzePosition(expr.get(), op);
     }
     return expr;
 }
@@ -276,7 +527,8 @@ std::unique_ptr<Expression> Parser::comparison() {      // Parst Vergleiche (<,
     while (match({TokenType::LT, TokenType::LTE, TokenType::GT, TokenType::GTE})) {
         Token op = previous();
         std::unique_ptr<Expression> rechts = term();
-        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert, std::move(rechts));
+        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert(), std::move(rechts));
+        setzePosition(expr.get(), op);
     }
     return expr;
 }
@@ -286,7 +538,8 @@ std::unique_ptr<Expression> Parser::term() {        // Parst Addition (+) und Su
     while (match({TokenType::PLUS, TokenType::MINUS})) {
         Token op = previous();
         std::unique_ptr<Expression> rechts = factor();
-        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert, std::move(rechts));
+        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert(), std::move(rechts));
+        setzePosition(expr.get(), op);
     }
     return expr;
 }
@@ -296,7 +549,8 @@ std::unique_ptr<Expression> Parser::factor() {      // Parst Multiplikation (*),
     while (match({TokenType::MULTIPLY, TokenType::DIVIDE, TokenType::MODULO})) {
         Token op = previous();
         std::unique_ptr<Expression> rechts = unary();
-        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert, std::move(rechts));
+        expr = std::make_unique<BinaryExpression>(std::move(expr), op.wert(), std::move(rechts));
+        setzePosition(expr.get(), op);
     }
     return expr;
 }
@@ -305,17 +559,22 @@ std::unique_ptr<Expression> Parser::unary() {       // Parst unäre Operatoren a
     if (match({TokenType::MINUS, TokenType::NOT, TokenType::NICHT})) {
         Token op = previous();
         std::unique_ptr<Expression> rechts = unary();
-        return std::make_unique<UnaryExpression>(op.wert, std::move(rechts));
+        auto expr = std::make_unique<UnaryExpression>(op.wert(), std::move(rechts));
+        setzePosition(expr.get(), op);
+        return expr;
     }
     return call();
 }
 
-std::unique_ptr<Expression> Parser::call() {        // Parst Funktionsaufrufe (...) und Array-Zugriffe [...] nach einem primären Ausdruck.
+std::unique_ptr<Expression> Parser::call() {        // Parst Funktionsaufrufe (...), Array-Zugriffe [...] und Feldzugriffe .feld nach einem primären Ausdruck.
+    Token start = peek();
     std::unique_ptr<Expression> expr = primary();
+    setzePosition(expr.get(), start);
 
     while (true) { 
         if (match({TokenType::LPAREN})) {
             auto callExpr = std::make_unique<CallExpression>();
+            setzePosition(callExpr.get(), start);
             callExpr->aufrufer = std::move(expr);
             // Argumente parsen
             if (!check(TokenType::RPAREN)) {
@@ -328,11 +587,19 @@ std::unique_ptr<Expression> Parser::call() {        // Parst Funktionsaufrufe (.
             
         } else if (match({TokenType::LBRACKET})) {
             auto accessExpr = std::make_unique<ArrayAccessExpression>();
+            setzePosition(accessExpr.get(), start);
             accessExpr->array = std::move(expr);
             accessExpr->index = expression();
             consume(TokenType::RBRACKET, "Erwarte ']' nach Array-Index");
             expr = std::move(accessExpr);
             
+        } else if (match({TokenType::DOT})) {
+            auto feldExpr = std::make_unique<FeldzugriffExpression>();
+            setzePosition(feldExpr.get(), start);
+            feldExpr->objekt = std::move(expr);
+            feldExpr->feld = consume(TokenType::IDENTIFIER, "Erwarte Feldnamen nach '.'").wert();
+            expr = std::move(feldExpr);
+
         } else {
             break;
         }
@@ -340,18 +607,18 @@ std::unique_ptr<Expression> Parser::call() {        // Parst Funktionsaufrufe (.
     return expr;
 }
 
-std::unique_ptr<Expression> Parser::primary() {     // Parst die "atomaren" Teile eines Ausdrucks: Literale (Zahlen, Strings, JA/NEIN), Variablennamen, geklammerte Ausdrücke, Array-Literale, LESE() und Typumwandlungen.
+std::unique_ptr<Expression> Parser::primary() {     // Parst die "atomaren" Teile eines Ausdrucks: Literale (Zahlen, Strings, JA/NEIN), Variablennamen, geklammerte Ausdrücke, Array- und KARTE-Literale, LESE(), LESE_ALLE(), LAENGE()/SUMME()/ENTHAELT()/SCHLUESSEL(), AUFGABE/WARTE und Typumwandlungen.
     if (match({TokenType::INT_LITERAL})) {
-        return std::make_unique<LiteralExpression>(std::stoi(previous().wert), "GANZ");
+        return std::make_unique<LiteralExpression>(ganzLiteral(previous()), "GANZ");
     }
     if (match({TokenType::FLOAT_LITERAL})) {
-        return std::make_unique<LiteralExpression>(std::stof(previous().wert), "KOMMA");
+        return std::make_unique<LiteralExpression>(kommaLiteral(previous()), "KOMMA");
     }
     if (match({TokenType::STRING_LITERAL})) {
-        return std::make_unique<LiteralExpression>(previous().wert, "WORT");
+        return std::make_unique<LiteralExpression>(previous().wert(), "WORT");
     }
     if (match({TokenType::BOOL_LITERAL})) {
-        bool wert = (previous().wert == "JA");
+        bool wert = (previous().text() == "JA");
         return std::make_unique<LiteralExpression>(wert, "JAIN");
     }
     if (match({TokenType::LBRACKET})) {
@@ -365,17 +632,60 @@ std::unique_ptr<Expression> Parser::primary() {     // Parst die "atomaren" Teil
         return arr;
     }
     if (match({TokenType::LESE})) {
+        auto lese = std::make_unique<LeseExpression>();
         consume(TokenType::LPAREN, "Erwarte '(' nach LESE");
+        if (!check(TokenType::RPAREN)) {
+            lese->quelle = expression();
+        }
         consume(TokenType::RPAREN, "Erwarte ')' nach LESE");
-        return std::make_unique<LeseExpression>();
+        return lese;
+    }
+    if (match({TokenType::LESE_ALLE})) {
+        consume(TokenType::LPAREN, "Erwarte '(' nach LESE_ALLE");
+        consume(TokenType::RPAREN, "Erwarte ')' nach LESE_ALLE");
+        return std::make_unique<LeseAlleExpression>();
+    }
+    if (match({TokenType::LBRACE})) {
+        auto karte = std::make_unique<KartenLiteralExpression>();
+        if (!check(TokenType::RBRACE)) {
+            do {
+                karte->schluessel.push_back(expression());
+                consume(TokenType::COLON, "Erwarte ':' nach dem Schlüssel im KARTE-Literal");
+                karte->werte.push_back(expression());
+            } while (match({TokenType::COMMA}));
+        }
+        consume(TokenType::RBRACE, "Erwarte '}' am Ende des KARTE-Literals");
+        return karte;
+    }
+    if (match({TokenType::LAENGE, TokenType::SUMME, TokenType::ENTHAELT, TokenType::SCHLUESSEL,
+               TokenType::DATEI_LESE, TokenType::DATEI_ZEILEN, TokenType::DATEI_ENDE})) {
+        return intrinsic();
+    }
+    if (match({TokenType::AUFGABE})) {
+        auto aufgabe = std::make_unique<AufgabeExpression>();
+        std::unique_ptr<Expression> aufruf = call();
+        auto ce = dynamic_cast<CallExpression*>(aufruf.get());
+        if (ce == nullptr || dynamic_cast<IdentifierExpression*>(ce->aufrufer.get()) == nullptr) {
+            throw ParseError("Zeile " + std::to_string(previous().zeile()) + ": AUFGABE erwartet einen Funktionsaufruf, z.B. AUFGABE f(x)");
+        }
+        aufruf.release();
+        aufgabe->aufruf.reset(ce);
+        return aufgabe;
+    }
+    if (match({TokenType::WARTE})) {
+        auto warte = std::make_unique<WarteExpression>();
+        consume(TokenType::LPAREN, "Erwarte '(' nach WARTE");
+        warte->aufgabe = expression();
+        consume(TokenType::RPAREN, "Erwarte ')' nach WARTE-Argument");
+        return warte;
     }
     if (match({TokenType::ZU_GANZ, TokenType::ZU_KOMMA, TokenType::ZU_WORT})) {
         Token typ = previous();
         auto conv = std::make_unique<TypeConversionExpression>();
         
-        if (typ.typ == TokenType::ZU_GANZ) conv->zielTyp = "GANZ";
-        if (typ.typ == TokenType::ZU_KOMMA) conv->zielTyp = "KOMMA";
-        if (typ.typ == TokenType::ZU_WORT) conv->zielTyp = "WORT";
+        if (typ.typ() == TokenType::ZU_GANZ) conv->zielTyp = "GANZ";
+        if (typ.typ() == TokenType::ZU_KOMMA) conv->zielTyp = "KOMMA";
+        if (typ.typ() == TokenType::ZU_WORT) conv->zielTyp = "WORT";
         
         consume(TokenType::LPAREN, "Erwarte '(' nach Typumwandlung");
         conv->expression = expression();
@@ -384,7 +694,7 @@ std::unique_ptr<Expression> Parser::primary() {     // Parst die "atomaren" Teil
         return conv;
     }
     if (match({TokenType::IDENTIFIER})) {
-        return std::make_unique<IdentifierExpression>(previous().wert);
+        return std::make_unique<IdentifierExpression>(previous().wert());
     }
     if (match({TokenType::LPAREN})) {
         std::unique_ptr<Expression> expr = expression();
@@ -392,17 +702,39 @@ std::unique_ptr<Expression> Parser::primary() {     // Parst die "atomaren" Teil
         return expr;
     }
 
-    throw ParseError("Zeile " + std::to_string(peek().zeile) + 
+    throw ParseError("Zeile " + std::to_string(peek().zeile()) + 
                      ": Erwarte Ausdruck (Zahl, String, Variable, '[', '(')");
 }
 
-std::string Parser::parseType() {       // Liest einen Typnamen (z.B. "GANZ" oder "WORT[]") aus dem Token-Stream.
-    if (!match({TokenType::GANZ, TokenType::WORT, TokenType::JAIN, TokenType::KISTE, TokenType::KOMMA})) {
-        throw ParseError("Zeile " + std::to_string(peek().zeile) + 
-                         ": Erwarte einen Typnamen (GANZ, WORT, KOMMA, KISTE, etc.)");
+bool Parser::istTyp() {     // Prüft, ob am aktuellen Token ein Typname beginnt: ein Typ-Schlüsselwort oder eine deklarierte STRUKTUR.
+    if (check(TokenType::GANZ) || check(TokenType::WORT) || check(TokenType::JAIN) || check(TokenType::KISTE) || check(TokenType::KOMMA) || check(TokenType::AUFGABE) ||
+        check(TokenType::KARTE) || check(TokenType::SICHT) || check(TokenType::ZEILEN)) {
+        return true;
+    }
+    return check(TokenType::IDENTIFIER) && m_strukturen.count(m_tokens.text(m_current)) > 0;
+}
+
+std::string Parser::parseType() {       // Liest einen Typnamen (z.B. "GANZ", "WORT[]", "Punkt[]" oder "KARTE<WORT,GANZ>") aus dem Token-Stream.
+    if (!istTyp()) {
+        throw ParseError("Zeile " + std::to_string(peek().zeile()) + 
+                         ": Erwarte einen Typnamen (GANZ, WORT, KOMMA, KISTE, AUFGABE, KARTE, SICHT, ZEILEN, STRUKTUR-Name, etc.)");
+    }
+    Token typ = advance();
+    std::string typName = typ.wert();
+    if (typ.typ() == TokenType::KARTE) {
+        consume(TokenType::LT, "Erwarte '<' nach KARTE");
+        std::string schluessel = parseType();
+        if (schluessel != "GANZ" && schluessel != "WORT" && schluessel != "KOMMA" && schluessel != "JAIN") {
+            throw ParseError("Zeile " + std::to_string(typ.zeile()) + ": Der Schlüssel einer KARTE muss GANZ, WORT, KOMMA oder JAIN sein");
+        }
+        consume(TokenType::COMMA, "Erwarte ',' nach dem Schlüsseltyp der KARTE");
+        std::string wert = parseType();
+        if (wert.rfind("AUFGABE", 0) == 0) {
+            throw ParseError("Zeile " + std::to_string(typ.zeile()) + ": AUFGABE ist als Werttyp einer KARTE nicht erlaubt");
+        }
+        consume(TokenType::GT, "Erwarte '>' nach dem Werttyp der KARTE");
+        typName += "<" + schluessel + "," + wert + ">";
     }
-    Token typ = previous();
-    std::string typName = typ.wert;
     
     if (match({TokenType::LBRACKET})) {
         consume(TokenType::RBRACKET, "Erwarte ']' nach '[' in Array-Typ");
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <initializer_list>
+#include <set>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -13,35 +15,49 @@ public:
 
 class Parser {
 public:
-    Parser(const std::vector<Token>& tokens);
+    Parser(TokenListe tokens);
     std::unique_ptr<Program> parse();
+    const std::vector<std::string>& fehler() const { return m_fehler; }     // Syntaxfehler, nach denen parse() weitergelesen hat.
 
 private:
-    std::vector<Token> m_tokens;
-    int m_current = 0;
+    TokenListe m_tokens;
+    std::size_t m_current = 0;
+    std::vector<std::string> m_fehler;
+    std::set<std::string, std::less<>> m_strukturen;      // Bisher deklarierte STRUKTUR-Namen; sie sind ab ihrer Deklaration Typen.
 
-    Token& peek();
-    Token& previous();
-    Token& advance();
+    Token peek();
+    Token previous();
+    Token advance();
     bool isAtEnd();
     bool check(TokenType typ);
-    bool match(std::vector<TokenType> typen);
-    Token& consume(TokenType typ, const std::string& errorMsg);
+    bool match(std::initializer_list<TokenType> typen);
+    Token consume(TokenType typ, const std::string& errorMsg);
 
     std::string parseType();
+    bool istTyp();
+    void setzePosition(ASTNode* knoten, const Token& token);
 
     std::unique_ptr<Statement> declaration();
+    bool istFunktionsKopf();
+    std::unique_ptr<Statement> merkeDeclaration();
+    std::unique_ptr<Statement> importDeclaration();
+    std::unique_ptr<Statement> strukturDeclaration(bool kompakt);
     std::unique_ptr<Statement> statement();
     std::unique_ptr<Statement> functionDeclaration();
     std::unique_ptr<Statement> variableDeclaration();
     std::unique_ptr<BlockStatement> blockStatement();
     std::unique_ptr<Statement> printStatement();
+    std::unique_ptr<Statement> flushStatement();
     std::unique_ptr<ReturnStatement> returnStatement();
     std::unique_ptr<Statement> ifStatement();
     std::unique_ptr<Statement> assignmentStatement();
     std::unique_ptr<Statement> whileStatement();
-    std::unique_ptr<Statement> forStatement();
+    std::unique_ptr<Statement> forStatement(bool parallel = false);
+    std::unique_ptr<Statement> fuerJedesStatement();
     std::unique_ptr<Statement> arrayAssignmentStatement();
+    std::unique_ptr<Statement> feldZuweisungStatement(std::unique_ptr<Expression> index);
+    std::unique_ptr<Statement> intrinsicStatement();
+    std::unique_ptr<IntrinsicExpression> intrinsic();
 
     std::unique_ptr<Expression> expression();
     std::unique_ptr<Expression> logicalOr();
@@ -1,14 +1,22 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <iostream>
 
-enum class TokenType {
-    GANZ, KOMMA, WORT, JAIN, KISTE,
-    WENN, SONST, SOLANGE, FUER,
+enum class TokenType : std::uint8_t {
+    GANZ, KOMMA, WORT, JAIN, KISTE, AUFGABE, KARTE, SICHT, ZEILEN,
+    WENN, SONST, SOLANGE, FUER, PARALLEL, JEDES, IN, WARTE, MERKE,
     UND, ODER, NICHT,
-    DRUCKE, LESE, ZURUECK,
+    DRUCKE, LESE, LESE_ALLE, LEERE, ZURUECK,
     ZU_GANZ, ZU_KOMMA, ZU_WORT, 
+    LAENGE, HINZUFUEGEN, SUMME, SORTIERE, ENTHAELT, SCHLUESSEL,
+    DATEI_LESE, DATEI_ZEILEN, DATEI_ENDE, DATEI_SCHREIBE,
     GIBFREI, HOLE, VON,
+    STRUKTUR, KOMPAKT,
     
     IDENTIFIER, INT_LITERAL, FLOAT_LITERAL, STRING_LITERAL, BOOL_LITERAL,
     
@@ -40,10 +48,36 @@ inline std::string tokenTypeToString(TokenType type) {
         case TokenType::SONST: return "SONST";
         case TokenType::SOLANGE: return "SOLANGE";
         case TokenType::FUER: return "FUER";
+        case TokenType::PARALLEL: return "PARALLEL";
+        case TokenType::JEDES: return "JEDES";
+        case TokenType::IN: return "IN";
+        case TokenType::AUFGABE: return "AUFGABE";
+        case TokenType::KARTE: return "KARTE";
+        case TokenType::SICHT: return "SICHT";
+        case TokenType::ZEILEN: return "ZEILEN";
+        case TokenType::WARTE: return "WARTE";
+        case TokenType::MERKE: return "MERKE";
+        case TokenType::HOLE: return "HOLE";
+        case TokenType::VON: return "VON";
+        case TokenType::STRUKTUR: return "STRUKTUR";
+        case TokenType::KOMPAKT: return "KOMPAKT";
         case TokenType::UND: return "UND";
         case TokenType::ODER: return "ODER";
         case TokenType::DRUCKE: return "DRUCKE";
+        case TokenType::LESE: return "LESE";
+        case TokenType::LESE_ALLE: return "LESE_ALLE";
+        case TokenType::LEERE: return "LEERE";
         case TokenType::ZURUECK: return "ZURUECK";
+        case TokenType::LAENGE: return "LAENGE";
+        case TokenType::HINZUFUEGEN: return "HINZUFUEGEN";
+        case TokenType::SUMME: return "SUMME";
+        case TokenType::SORTIERE: return "SORTIERE";
+        case TokenType::ENTHAELT: return "ENTHAELT";
+        case TokenType::SCHLUESSEL: return "SCHLUESSEL";
+        case TokenType::DATEI_LESE: return "DATEI_LESE";
+        case TokenType::DATEI_ZEILEN: return "DATEI_ZEILEN";
+        case TokenType::DATEI_ENDE: return "DATEI_ENDE";
+        case TokenType::DATEI_SCHREIBE: return "DATEI_SCHREIBE";
         
         case TokenType::IDENTIFIER: return "IDENTIFIER";
         case TokenType::INT_LITERAL: return "INT_LITERAL";
@@ -78,19 +112,95 @@ inline std::string tokenTypeToString(TokenType type) {
     }
 }
 
+class TokenListe;
+
+// Sicht auf ein Token in einer TokenListe. Wird als Wert weitergegeben; Text und Position
+// werden erst beim Zugriff aus dem Quelltext bzw. der Zeilentabelle geholt.
 class Token {
 public:
-    TokenType typ;
-    std::string wert;
-    int zeile;
-    int spalte;
-
-    Token(TokenType t, std::string w, int z, int s)
-        : typ(t), wert(w), zeile(z), spalte(s) {}
-
-    void print() const {
-        std::cout << "Zeile " << zeile << ", Spalte " << spalte
-                  << ":\t" << tokenTypeToString(typ)
-                  << "\t'" << wert << "'" << std::endl;
+    Token(const TokenListe* liste, std::uint32_t index) : m_liste(liste), m_index(index) {}
+
+    TokenType typ() const;
+    std::string_view text() const;
+    std::string wert() const { return std::string(text()); }
+    int zeile() const;
+    int spalte() const;
+    std::pair<int, int> position() const;
+    void print() const;
+
+private:
+    const TokenListe* m_liste;
+    std::uint32_t m_index;
+};
+
+// Alle Tokens eines Quelltexts als parallele Arrays (1 Byte Art, je 4 Byte Offset und Länge),
+// statt einem Objekt mit eigenem String pro Token. Der Parser liest in check() nur m_typen.
+// Zeile und Spalte stehen nicht im Token: Beim ersten Zugriff wird einmal eine Tabelle der
+// Zeilenanfänge aufgebaut und danach binär gesucht.
+class TokenListe {
+public:
+    static constexpr std::size_t MAXIMALE_LAENGE = UINT32_MAX;     // Offsets und Längen sind 32 Bit; der Lexer lehnt längere Quelltexte ab.
+
+    explicit TokenListe(std::string quelltext) : m_quelltext(std::move(quelltext)) {}
+
+    void hinzufuegen(TokenType typ, std::uint32_t offset, std::uint32_t laenge) {
+        m_typen.push_back(static_cast<std::uint8_t>(typ));
+        m_offsets.push_back(offset);
+        m_laengen.push_back(laenge);
     }
-};
\ No newline at end of file
+
+    void reserve(std::size_t anzahl) {
+        m_typen.reserve(anzahl);
+        m_offsets.reserve(anzahl);
+        m_laengen.reserve(anzahl);
+    }
+
+    std::size_t size() const { return m_typen.size(); }
+    Token operator[](std::size_t i) const { return Token(this, static_cast<std::uint32_t>(i)); }
+    const std::string& quelltext() const { return m_quelltext; }
+
+    TokenType typ(std::size_t i) const { return static_cast<TokenType>(m_typen[i]); }
+    std::string_view text(std::size_t i) const {
+        return std::string_view(m_quelltext).substr(m_offsets[i], m_laengen[i]);
+    }
+    int zeile(std::size_t i) const { return position(i).first; }
+    int spalte(std::size_t i) const { return position(i).second; }
+    std::pair<int, int> position(std::size_t i) const {        // Zeile und Spalte (ab 1) mit einer Suche. Die Spalte zählt Zeichen, nicht Bytes: UTF-8-Folgebytes zählen nicht mit.
+        std::size_t z = zeilenIndex(m_offsets[i]);
+        int spalte = 1;
+        for (std::size_t b = m_zeilenAnfaenge[z]; b < m_offsets[i]; ++b) {
+            if ((static_cast<unsigned char>(m_quelltext[b]) & 0xC0) != 0x80) ++spalte;
+        }
+        return {static_cast<int>(z) + 1, spalte};
+    }
+
+private:
+    std::string m_quelltext;
+    std::vector<std::uint8_t> m_typen;
+    std::vector<std::uint32_t> m_offsets;
+    std::vector<std::uint32_t> m_laengen;
+    mutable std::vector<std::uint32_t> m_zeilenAnfaenge;      // Offset des ersten Zeichens jeder Zeile, erst bei Bedarf gefüllt.
+
+    std::size_t zeilenIndex(std::uint32_t offset) const {      // Nullbasierte Zeile, in der `offset` liegt.
+        if (m_zeilenAnfaenge.empty()) {
+            m_zeilenAnfaenge.push_back(0);
+            for (std::size_t i = 0; i < m_quelltext.size(); ++i) {
+                if (m_quelltext[i] == '\n') m_zeilenAnfaenge.push_back(static_cast<std::uint32_t>(i + 1));
+            }
+        }
+        auto it = std::upper_bound(m_zeilenAnfaenge.begin(), m_zeilenAnfaenge.end(), offset);
+        return static_cast<std::size_t>(it - m_zeilenAnfaenge.begin()) - 1;
+    }
+};
+
+inline TokenType Token::typ() const { return m_liste->typ(m_index); }
+inline std::string_view Token::text() const { return m_liste->text(m_index); }
+inline int Token::zeile() const { return m_liste->zeile(m_index); }
+inline int Token::spalte() const { return m_liste->spalte(m_index); }
+inline std::pair<int, int> Token::position() const { return m_liste->position(m_index); }
+
+inline void Token::print() const {
+    std::cout << "Zeile " << zeile() << ", Spalte " << spalte()
+              << ":\t" << tokenTypeToString(typ())
+              << "\t'" << text() << "'" << std::endl;
+}